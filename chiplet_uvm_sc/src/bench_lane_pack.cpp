@@ -0,0 +1,135 @@
+// Per-transaction conversion cost of lane_txn, conversion only. This is
+// not the cost of a UVMC crossing: no UVMC, DPI or simulator is involved.
+//
+//   bench_lane_pack [n_txns] [reps]
+//
+// bit_packer below is a hand-written stand-in for UVMC's packer: it
+// streams each field bit by bit into a bit vector and back, with the same
+// field widths. It is not UVMC's code, so absolute numbers say nothing
+// about UVMC; only the ratios between the paths mean anything:
+//   legacy  the previous lane_txn layout, four sc_uint<> fields, through
+//           bit_packer
+//   native  the current lane_txn, plain integer fields, through bit_packer
+//   bulk    pack_lane_txns/unpack_lane_txns over the whole vector plus the
+//           byte image, i.e. the conversion for one batch of n
+// The real crossing (UVMC packing, DPI call, simulator) comes on top and
+// has to be measured in the simulator.
+
+#include <systemc>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "lane_txn.hpp"
+
+namespace {
+
+// Bit-stream packer with UVMC's field semantics
+class bit_packer {
+public:
+  void reset() { bits_.clear(); pos_ = 0; n_ = 0; }
+  void rewind() { pos_ = 0; }
+
+  template <int W> bit_packer& operator<<(const sc_dt::sc_uint<W>& v) { put(v.to_uint64(), W); return *this; }
+  bit_packer& operator<<(std::uint32_t v) { put(v, 32); return *this; }
+  bit_packer& operator<<(std::uint8_t v)  { put(v, 8);  return *this; }
+  bit_packer& operator<<(bool v)          { put(v, 1);  return *this; }
+
+  template <int W> bit_packer& operator>>(sc_dt::sc_uint<W>& v) { v = get(W); return *this; }
+  bit_packer& operator>>(std::uint32_t& v) { v = static_cast<std::uint32_t>(get(32)); return *this; }
+  bit_packer& operator>>(std::uint8_t& v)  { v = static_cast<std::uint8_t>(get(8));   return *this; }
+  bit_packer& operator>>(bool& v)          { v = get(1) != 0; return *this; }
+
+private:
+  void put(std::uint64_t v, unsigned w) {
+    for (unsigned i = 0; i < w; ++i, ++n_) {
+      if ((n_ & 31) == 0) bits_.push_back(0);
+      bits_.back() |= static_cast<std::uint32_t>((v >> i) & 1u) << (n_ & 31);
+    }
+  }
+  std::uint64_t get(unsigned w) {
+    std::uint64_t v = 0;
+    for (unsigned i = 0; i < w; ++i, ++pos_) {
+      v |= std::uint64_t((bits_[pos_ >> 5] >> (pos_ & 31)) & 1u) << i;
+    }
+    return v;
+  }
+
+  std::vector<std::uint32_t> bits_;
+  unsigned                   pos_{0};
+  unsigned                   n_{0};
+};
+
+// lane_txn as it was before the native layout
+struct legacy_lane_txn {
+  sc_dt::sc_uint<32> addr{0};
+  sc_dt::sc_uint<32> data{0};
+  bool               write{false};
+  sc_dt::sc_uint<8>  chiplet_id{0};
+
+  template <typename PACKER> void do_pack(PACKER& p) const   { p << addr << data << write << chiplet_id; }
+  template <typename PACKER> void do_unpack(PACKER& p)       { p >> addr >> data >> write >> chiplet_id; }
+};
+
+template <class T>
+double per_txn_convert(std::vector<T>& txns, unsigned reps) {
+  bit_packer p;
+  T back;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < reps; ++r) {
+    for (auto& t : txns) {
+      p.reset();
+      t.do_pack(p);      // SC -> SV
+      p.rewind();
+      back.do_unpack(p); // SV -> SC
+      t.data = back.data;
+    }
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(txns.size()) * reps);
+}
+
+double per_txn_bulk(std::vector<lane_txn>& txns, unsigned reps) {
+  std::vector<lane_txn_packed> packed;
+  std::vector<unsigned char>   bytes;
+  std::vector<lane_txn>        back;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < reps; ++r) {
+    pack_lane_txns(txns, packed);
+    packed_to_bytes(packed, bytes);
+    bytes_to_packed(bytes.data(), bytes.size(), packed);
+    unpack_lane_txns(packed, back);
+    txns[r % txns.size()].data = back[r % back.size()].data;
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(txns.size()) * reps);
+}
+
+} // namespace
+
+int sc_main(int argc, char* argv[]) {
+  const std::size_t n    = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : 4096;
+  const unsigned    reps = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 0)) : 200;
+
+  std::vector<legacy_lane_txn> legacy(n);
+  std::vector<lane_txn>        native(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::uint32_t a = static_cast<std::uint32_t>(i * 4);
+    legacy[i].addr = a; legacy[i].data = ~a; legacy[i].write = i & 1; legacy[i].chiplet_id = i & 3;
+    native[i].addr = a; native[i].data = ~a; native[i].write = i & 1; native[i].chiplet_id = i & 3;
+  }
+
+  const double t_legacy = per_txn_convert(legacy, reps);
+  const double t_native = per_txn_convert(native, reps);
+  const double t_bulk   = per_txn_bulk(native, reps);
+
+  std::cout << "[BENCH] lane_txn conversion only (hand-written bit packer, not UVMC;"
+            << " excludes the crossing itself), n=" << n << " reps=" << reps << "\n"
+            << "  legacy sc_uint fields, bit packer : " << t_legacy << " ns/txn\n"
+            << "  native fields, bit packer         : " << t_native << " ns/txn ("
+            << t_legacy / t_native << "x)\n"
+            << "  bulk packed vector                : " << t_bulk   << " ns/txn ("
+            << t_legacy / t_bulk << "x)\n";
+  return 0;
+}
@@ -1,24 +1,107 @@
 #pragma once
 #include <systemc>
 #include <tlm>
+#include <tlm_utils/simple_target_socket.h>
+#include <tlm_utils/peq_with_get.h>
 #include "lane_txn.hpp"
+#include "sparse_mem.hpp"
+#include <cstring>
 
+// Chiplet endpoint. Serves both protocols on one socket:
+//   LT  b_transport annotates `latency` on the delay
+//   AT  BEGIN_REQ is accepted at once (END_REQ) into a request queue; a
+//       worker serves the queue in order, one `latency` per request, and
+//       answers with BEGIN_RESP on the backward path
+// Backing store is a sparse 32-bit address space (see sparse_mem): writes
+// are kept, reads return them, never-written bytes read as zero.
 struct chiplet : sc_core::sc_module {
-  tlm::tlm_target_socket<> t_skt; // receive routed txns
+  tlm_utils::simple_target_socket<chiplet> t_skt; // receive routed txns
   unsigned id;
+  sc_core::sc_time latency;       // access time, annotated on the delay
+  sparse_mem       mem;
 
   SC_HAS_PROCESS(chiplet);
-  chiplet(sc_core::sc_module_name nm, unsigned id_) : sc_module(nm), t_skt("t_skt"), id(id_) {
+  chiplet(sc_core::sc_module_name nm, unsigned id_,
+          sc_core::sc_time latency_ = sc_core::sc_time(10, sc_core::SC_NS))
+  : sc_module(nm), t_skt("t_skt"), id(id_), latency(latency_), req_q("req_q") {
     t_skt.register_b_transport(this, &chiplet::b_transport);
+    t_skt.register_nb_transport_fw(this, &chiplet::nb_transport_fw);
+    t_skt.register_transport_dbg(this, &chiplet::transport_dbg);
+    SC_THREAD(req_thread);
   }
 
   void b_transport(tlm::tlm_generic_payload& gp, sc_core::sc_time& delay) {
+    execute(gp);
+    // Loosely timed: no wait() here, the initiator's quantum keeper decides
+    // when to synchronize.
+    delay += latency;
+  }
+
+  tlm::tlm_sync_enum nb_transport_fw(tlm::tlm_generic_payload& gp,
+                                     tlm::tlm_phase& phase, sc_core::sc_time& delay) {
+    if (phase == tlm::BEGIN_REQ) {
+      req_q.notify(gp, delay);
+      phase = tlm::END_REQ;
+      return tlm::TLM_UPDATED;
+    }
+    if (phase == tlm::END_RESP) {
+      end_resp_ev.notify(delay);
+      return tlm::TLM_COMPLETED;
+    }
+    return tlm::TLM_ACCEPTED;
+  }
+
+  // Backdoor access to the backing store, no timing
+  unsigned transport_dbg(tlm::tlm_generic_payload& gp) {
+    const uint32_t addr = static_cast<uint32_t>(gp.get_address());
+    unsigned char* d    = gp.get_data_ptr();
+    const unsigned len  = gp.get_data_length();
+    if (!d) return 0;
+    if (gp.is_write())     mem.write(addr, d, len);
+    else if (gp.is_read()) mem.read(addr, d, len);
+    else return 0;
+    return len;
+  }
+
+private:
+  // Address and direction come from the lane_txn extension when present.
+  // Without a data buffer a single word moves through lane_txn::data.
+  void execute(tlm::tlm_generic_payload& gp) {
     lane_txn* lt = gp.get_extension<lane_txn>();
-    if(lt && !lt->write) {
-      uint32_t val = static_cast<uint32_t>(lt->addr.to_uint()) ^ id;
-      unsigned char* d = gp.get_data_ptr();
-      if(d) *reinterpret_cast<uint32_t*>(d) = val;
+    const uint32_t addr  = lt ? lt->addr : static_cast<uint32_t>(gp.get_address());
+    const bool     write = lt ? lt->write : gp.is_write();
+    unsigned char* d     = gp.get_data_ptr();
+    const unsigned len   = gp.get_data_length();
+
+    if (d && len) {
+      if (write) mem.write(addr, d, len);
+      else       mem.read(addr, d, len);
+      if (lt && !write && len >= 4) {
+        std::memcpy(&lt->data, d, sizeof(lt->data));
+      }
+    } else if (lt) {
+      auto* w = reinterpret_cast<unsigned char*>(&lt->data);
+      if (write) mem.write(addr, w, sizeof(lt->data));
+      else       mem.read(addr, w, sizeof(lt->data));
     }
-    wait(sc_core::sc_time(10, sc_core::SC_NS));
+    gp.set_response_status(tlm::TLM_OK_RESPONSE);
   }
+
+  void req_thread() {
+    while (true) {
+      wait(req_q.get_event());
+      while (tlm::tlm_generic_payload* gp = req_q.get_next_transaction()) {
+        execute(*gp);
+        wait(latency);
+
+        tlm::tlm_phase   phase = tlm::BEGIN_RESP;
+        sc_core::sc_time t     = sc_core::SC_ZERO_TIME;
+        // Only one response may be open at a time on the socket
+        if (t_skt->nb_transport_bw(*gp, phase, t) == tlm::TLM_ACCEPTED) wait(end_resp_ev);
+      }
+    }
+  }
+
+  tlm_utils::peq_with_get<tlm::tlm_generic_payload> req_q;
+  sc_core::sc_event                                 end_resp_ev;
 };
@@ -1,19 +1,213 @@
 #pragma once
 #include <systemc>
 #include <tlm>
-#include <uvmc.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <tlm_utils/tlm_quantumkeeper.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
 #include "lane_txn.hpp"
 
+enum class lane_mode { lt, at };
+
 // Driver endpoint that receives UVMC TLM2 transactions from SV
+//
+// Callers always use b_transport; the mode selects how the driver talks to
+// the lane:
+//   LT  blocking, temporally decoupled: the latency annotated downstream
+//       accumulates in a quantum keeper and the driver only yields once the
+//       global quantum is used up (a zero quantum syncs after every txn).
+//       t_skt and the batch path each keep their own keeper, and a keeper's
+//       local offset is dropped when global time has moved on since its
+//       last call (the caller waited in between, so the offset is stale)
+//   AT  non-blocking base protocol: each call becomes a BEGIN_REQ and
+//       completes on BEGIN_RESP, with up to `outstanding` calls in flight
+//       at once (concurrent callers beyond that block)
+//
+// Batches arrive on b_skt: one generic payload whose data is an array of
+// lane_txn_packed records. Each record is forwarded into the lane as its
+// own transaction (in order for LT, up to `outstanding` at a time for AT)
+// and its response status and read data are written back into the record
+// before returning. The batch itself answers TLM_OK_RESPONSE only if every
+// record did; otherwise it carries the first failing record's status.
 struct lane_driver_sc : sc_core::sc_module {
-  tlm::tlm_initiator_socket<>  i_skt; // to mp_lane
-  tlm::tlm_target_socket<>     t_skt; // from SV via UVMC
+  tlm_utils::simple_initiator_socket<lane_driver_sc> i_skt; // to mp_lane
+  tlm_utils::simple_target_socket<lane_driver_sc>    t_skt; // from SV via UVMC
+  tlm_utils::simple_target_socket<lane_driver_sc>    b_skt; // batches from SV via UVMC
 
-  SC_CTOR(lane_driver_sc) : i_skt("i_skt"), t_skt("t_skt") {
+  SC_HAS_PROCESS(lane_driver_sc);
+  lane_driver_sc(sc_core::sc_module_name nm,
+                 lane_mode mode_ = lane_mode::lt, unsigned outstanding = 4)
+  : sc_module(nm), i_skt("i_skt"), t_skt("t_skt"), b_skt("b_skt"),
+    mode(mode_), max_outstanding(outstanding ? outstanding : 1),
+    slots(static_cast<int>(max_outstanding)) {
     t_skt.register_b_transport(this, &lane_driver_sc::b_transport);
+    b_skt.register_b_transport(this, &lane_driver_sc::b_transport_batch);
+    i_skt.register_nb_transport_bw(this, &lane_driver_sc::nb_transport_bw);
   }
 
   void b_transport(tlm::tlm_generic_payload& gp, sc_core::sc_time& delay) {
-    i_skt->b_transport(gp, delay);
+    transport(gp, delay, single_lt);
+  }
+
+  void b_transport_batch(tlm::tlm_generic_payload& gp, sc_core::sc_time& delay) {
+    unsigned char* d   = gp.get_data_ptr();
+    const unsigned len = gp.get_data_length();
+    if (!bytes_to_packed(d, len, batch)) {
+      gp.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+      return;
+    }
+    wait(delay);   // the batch is forwarded from "now"
+    if (mode == lane_mode::lt || batch.size() == 1) {
+      txn_slot& s = fwd_slot(0);
+      for (auto& r : batch) s.forward(*this, r);
+    } else {
+      // Workers pull records until none are left; at most `outstanding`
+      std::size_t next = 0;
+      const unsigned n = static_cast<unsigned>(std::min<std::size_t>(max_outstanding, batch.size()));
+      sc_core::sc_event_and_list done;
+      std::vector<sc_core::sc_process_handle> workers;
+      for (unsigned w = 0; w < n; ++w) {
+        txn_slot* s = &fwd_slot(w);
+        workers.push_back(sc_core::sc_spawn([this, s, &next] {
+          while (next < batch.size()) s->forward(*this, batch[next++]);
+        }));
+      }
+      for (auto& h : workers) if (!h.terminated()) done &= h.terminated_event();
+      if (done.size()) wait(done);
+    }
+    if (len) std::memcpy(d, batch.data(), len);   // status and read data back to the caller
+    tlm::tlm_response_status st = tlm::TLM_OK_RESPONSE;
+    for (const auto& r : batch) {
+      if (r.status != tlm::TLM_OK_RESPONSE) { st = static_cast<tlm::tlm_response_status>(r.status); break; }
+    }
+    gp.set_response_status(st);
+    delay = sc_core::SC_ZERO_TIME;
+  }
+
+  const lane_mode mode;
+  const unsigned  max_outstanding;
+
+private:
+  // LT decoupling state of one caller
+  struct lt_caller {
+    tlm_utils::tlm_quantumkeeper qk;
+    sc_core::sc_time             last;   // sc_time_stamp() when the last call returned
+
+    lt_caller() { qk.reset(); }
+  };
+
+  void transport(tlm::tlm_generic_payload& gp, sc_core::sc_time& delay, lt_caller& c) {
+    if (mode == lane_mode::at) {
+      transport_at(gp, delay);
+      return;
+    }
+    if (sc_core::sc_time_stamp() != c.last) c.qk.reset();   // stale offset
+    c.qk.inc(delay);
+    sc_core::sc_time local = c.qk.get_local_time();
+    i_skt->b_transport(gp, local);
+    c.qk.set(local);
+    if (c.qk.need_sync()) c.qk.sync();
+    c.last = sc_core::sc_time_stamp();
+    delay  = sc_core::SC_ZERO_TIME;   // consumed here
+  }
+
+  // Reusable payload + extension for forwarding one batch record
+  struct txn_slot {
+    tlm::tlm_generic_payload gp;
+    lane_txn                 ext;
+    std::uint32_t            word{0};
+
+    txn_slot()  { gp.set_extension(&ext); }
+    ~txn_slot() { gp.clear_extension(&ext); }
+
+    void forward(lane_driver_sc& drv, lane_txn_packed& r) {
+      ext.unpack(r);
+      word = r.data;
+      gp.set_command(r.write ? tlm::TLM_WRITE_COMMAND : tlm::TLM_READ_COMMAND);
+      gp.set_address(r.addr);
+      gp.set_data_ptr(reinterpret_cast<unsigned char*>(&word));
+      gp.set_data_length(sizeof(word));
+      gp.set_streaming_width(sizeof(word));
+      gp.set_byte_enable_ptr(nullptr);
+      gp.set_dmi_allowed(false);
+      gp.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+      sc_core::sc_time t = sc_core::SC_ZERO_TIME;
+      drv.transport(gp, t, drv.batch_lt);
+      r.status = static_cast<std::int8_t>(gp.get_response_status());
+      if (!r.write && gp.is_response_ok()) r.data = word;
+    }
+  };
+
+  txn_slot& fwd_slot(unsigned i) {
+    while (fwd_slots.size() <= i) fwd_slots.push_back(std::make_unique<txn_slot>());
+    return *fwd_slots[i];
+  }
+
+  void transport_at(tlm::tlm_generic_payload& gp, sc_core::sc_time& delay) {
+    slots.wait();
+    while (req_open) wait(end_req_ev);   // one request phase at a time
+
+    sc_core::sc_event done;
+    pending[&gp] = &done;
+    req_open = &gp;
+
+    tlm::tlm_phase     phase = tlm::BEGIN_REQ;
+    sc_core::sc_time   t     = delay;
+    tlm::tlm_sync_enum s     = i_skt->nb_transport_fw(gp, phase, t);
+
+    if (s == tlm::TLM_COMPLETED) {
+      end_request(gp, t);
+      wait(t);
+    } else {
+      if (s == tlm::TLM_UPDATED) {
+        if (phase == tlm::END_REQ) end_request(gp, t);
+        else if (phase == tlm::BEGIN_RESP) {
+          end_request(gp, t);
+          done.notify(t);
+          phase = tlm::END_RESP;
+          sc_core::sc_time t2 = t;
+          i_skt->nb_transport_fw(gp, phase, t2);
+        }
+      }
+      wait(done);
+    }
+
+    pending.erase(&gp);
+    slots.post();
+    delay = sc_core::SC_ZERO_TIME;
+  }
+
+  tlm::tlm_sync_enum nb_transport_bw(tlm::tlm_generic_payload& gp,
+                                     tlm::tlm_phase& phase, sc_core::sc_time& t) {
+    if (phase == tlm::END_REQ) {
+      end_request(gp, t);
+      return tlm::TLM_ACCEPTED;
+    }
+    if (phase == tlm::BEGIN_RESP) {
+      end_request(gp, t);   // BEGIN_RESP implies END_REQ
+      auto it = pending.find(&gp);
+      if (it != pending.end()) it->second->notify(t);
+      return tlm::TLM_COMPLETED;
+    }
+    return tlm::TLM_ACCEPTED;
   }
+
+  void end_request(tlm::tlm_generic_payload& gp, const sc_core::sc_time& t) {
+    if (req_open != &gp) return;
+    req_open = nullptr;
+    end_req_ev.notify(t);
+  }
+
+  lt_caller                                                 single_lt; // t_skt
+  lt_caller                                                 batch_lt;  // b_skt records
+  sc_core::sc_semaphore                                     slots;
+  std::map<tlm::tlm_generic_payload*, sc_core::sc_event*>   pending;   // AT: open calls
+  std::vector<lane_txn_packed>                              batch;     // current batch (one at a time)
+  std::vector<std::unique_ptr<txn_slot>>                    fwd_slots;
+  tlm::tlm_generic_payload*                                 req_open{nullptr};
+  sc_core::sc_event                                         end_req_ev;
 };
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Arbitration policy for one mp_lane link. pick() gets the upstream driver
+// indexes currently waiting for the link, in arrival order, and returns the
+// position of the winner in that list.
+struct lane_arbiter {
+  virtual ~lane_arbiter() = default;
+  virtual std::size_t pick(const std::vector<int>& requesters) = 0;
+};
+
+// Lowest driver index wins
+struct fixed_priority_arbiter : lane_arbiter {
+  std::size_t pick(const std::vector<int>& req) override {
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < req.size(); ++i)
+      if (req[i] < req[best]) best = i;
+    return best;
+  }
+};
+
+// First requester after the last winner, in cyclic driver order
+struct round_robin_arbiter : lane_arbiter {
+  std::size_t pick(const std::vector<int>& req) override {
+    std::size_t best = 0;
+    int best_dist = -1;
+    for (std::size_t i = 0; i < req.size(); ++i) {
+      const int d = distance(req[i]);
+      if (best_dist < 0 || d < best_dist) { best = i; best_dist = d; }
+    }
+    last = req[best];
+    return best;
+  }
+
+protected:
+  // Positions after `last` in cyclic order (1 = next in line)
+  int distance(int drv) const {
+    const int span = 1 << 16;
+    return ((drv - last - 1) % span + span) % span;
+  }
+
+  int last{-1};
+};
+
+// Weighted round robin: driver k gets up to weights[k] grants per round
+// (missing weights count as 1). A round ends when no waiting driver has
+// credit left.
+struct weighted_arbiter : round_robin_arbiter {
+  explicit weighted_arbiter(std::vector<unsigned> w) : weights(std::move(w)) {}
+
+  std::size_t pick(const std::vector<int>& req) override {
+    if (!any_credit(req)) credit.clear();
+    std::size_t best = 0;
+    int best_dist = -1;
+    for (std::size_t i = 0; i < req.size(); ++i) {
+      if (used(req[i]) >= weight(req[i])) continue;
+      const int d = distance(req[i]);
+      if (best_dist < 0 || d < best_dist) { best = i; best_dist = d; }
+    }
+    ++used(req[best]);
+    last = req[best];
+    return best;
+  }
+
+private:
+  unsigned weight(int drv) const {
+    return static_cast<std::size_t>(drv) < weights.size() && weights[drv] ? weights[drv] : 1u;
+  }
+  unsigned& used(int drv) {
+    if (static_cast<std::size_t>(drv) >= credit.size()) credit.resize(drv + 1, 0);
+    return credit[drv];
+  }
+  bool any_credit(const std::vector<int>& req) {
+    for (int d : req) if (used(d) < weight(d)) return true;
+    return false;
+  }
+
+  std::vector<unsigned> weights;
+  std::vector<unsigned> credit;   // grants used this round
+};
+
+// "rr" (default), "fixed" or "weighted"
+inline std::unique_ptr<lane_arbiter> make_lane_arbiter(const std::string& kind,
+                                                       const std::vector<unsigned>& weights) {
+  if (kind == "fixed")    return std::make_unique<fixed_priority_arbiter>();
+  if (kind == "weighted") return std::make_unique<weighted_arbiter>(weights);
+  return std::make_unique<round_robin_arbiter>();
+}
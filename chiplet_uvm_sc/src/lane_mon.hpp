@@ -0,0 +1,158 @@
+#pragma once
+#include <systemc>
+#include <tlm>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "lane_txn.hpp"
+
+// One transaction as seen by the lane: what went through, between which
+// driver and chiplet, when it entered the lane and how long it took to
+// complete (request in to response out, link queueing included).
+struct lane_obs {
+  lane_txn                 txn;
+  unsigned                 from{0};       // driver index
+  unsigned                 to{0};         // chiplet index
+  sc_core::sc_time         start;
+  sc_core::sc_time         latency;
+  tlm::tlm_response_status status{tlm::TLM_INCOMPLETE_RESPONSE};
+};
+
+// Fixed-layout image of a lane_obs, the record format of one monitor batch
+// on the UVMC "mon" channel (mon_pkg::lane_monitor unpacks it).
+struct lane_obs_packed {
+  lane_txn_packed txn;
+  std::uint8_t    from;
+  std::int8_t     status;       // tlm_response_status
+  std::uint16_t   rsvd;
+  std::uint64_t   start_ps;
+  std::uint64_t   latency_ps;
+};
+static_assert(std::is_trivially_copyable<lane_obs_packed>::value, "lane_obs_packed must be trivially copyable");
+static_assert(sizeof(lane_obs_packed) == 32,                      "lane_obs_packed layout changed");
+static_assert(offsetof(lane_obs_packed, start_ps) == 16,          "lane_obs_packed layout changed");
+
+inline lane_obs_packed pack_lane_obs(const lane_obs& o) {
+  const double ps = sc_core::sc_time(1, sc_core::SC_PS).to_seconds();
+  return lane_obs_packed{o.txn.pack(),
+                         static_cast<std::uint8_t>(o.from),
+                         static_cast<std::int8_t>(o.status),
+                         0,
+                         static_cast<std::uint64_t>(o.start.to_seconds() / ps + 0.5),
+                         static_cast<std::uint64_t>(o.latency.to_seconds() / ps + 0.5)};
+}
+
+// Single-producer/single-consumer ring of N (a power of two) slots. Neither
+// side ever blocks or allocates: push fails when full, pop when empty.
+template <class T, std::size_t N>
+class spsc_ring {
+  static_assert(N && (N & (N - 1)) == 0, "spsc_ring size must be a power of two");
+public:
+  bool push(const T& v) {
+    const std::size_t h = head_.load(std::memory_order_relaxed);
+    if (h - tail_.load(std::memory_order_acquire) == N) return false;
+    buf_[h & (N - 1)] = v;
+    head_.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  bool pop(T& v) {
+    const std::size_t t = tail_.load(std::memory_order_relaxed);
+    if (t == head_.load(std::memory_order_acquire)) return false;
+    v = buf_[t & (N - 1)];
+    tail_.store(t + 1, std::memory_order_release);
+    return true;
+  }
+  std::size_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+  bool empty() const { return size() == 0; }
+
+private:
+  std::array<T, N>         buf_{};
+  std::atomic<std::size_t> head_{0};
+  std::atomic<std::size_t> tail_{0};
+};
+
+// Monitor tap: subscribes to mp_lane::mon_ap and forwards observations over
+// i_skt (the UVMC "mon" channel) in batches. The lane's write() only
+// drops the observation into a ring; a separate process drains it, so the
+// data path never waits on the SV side. A batch goes out once `batch`
+// observations are queued or `window` after the first one, as a single
+// generic payload of lane_obs_packed records. Observations that find the
+// ring full are dropped and counted.
+struct lane_mon_tap : sc_core::sc_module, tlm::tlm_analysis_if<lane_obs> {
+  static constexpr std::size_t ring_size = 1024;
+
+  tlm_utils::simple_initiator_socket<lane_mon_tap> i_skt;  // to SV via UVMC
+
+  std::uint64_t seen{0};
+  std::uint64_t dropped{0};
+  std::uint64_t batches{0};
+
+  SC_HAS_PROCESS(lane_mon_tap);
+  lane_mon_tap(sc_core::sc_module_name nm, unsigned batch_ = 64,
+               sc_core::sc_time window_ = sc_core::sc_time(100, sc_core::SC_NS))
+  : sc_module(nm), i_skt("i_skt"),
+    batch(batch_ ? (batch_ < ring_size ? batch_ : ring_size) : 1), window(window_) {
+    SC_THREAD(drain);
+  }
+
+  void write(const lane_obs& o) override {
+    ++seen;
+    if (!ring.push(pack_lane_obs(o))) { ++dropped; return; }
+    const std::size_t n = ring.size();
+    if (n == 1)     first_ev.notify(sc_core::SC_ZERO_TIME);
+    if (n >= batch) full_ev.notify(sc_core::SC_ZERO_TIME);
+  }
+
+protected:
+  void end_of_simulation() override {
+    std::string msg = "observed=" + std::to_string(seen) + " batches=" + std::to_string(batches);
+    if (dropped) msg += " dropped=" + std::to_string(dropped);
+    if (dropped || !ring.empty()) SC_REPORT_WARNING(name(), msg.c_str());
+    else                          SC_REPORT_INFO(name(), msg.c_str());
+  }
+
+private:
+  void drain() {
+    while (true) {
+      if (ring.empty())        wait(first_ev);
+      if (ring.size() < batch) wait(window, full_ev);
+      flush();
+    }
+  }
+
+  void flush() {
+    out.clear();
+    lane_obs_packed r;
+    while (out.size() < batch && ring.pop(r)) out.push_back(r);
+    if (out.empty()) return;
+
+    bytes.resize(out.size() * sizeof(lane_obs_packed));
+    std::memcpy(bytes.data(), out.data(), bytes.size());
+    gp.set_command(tlm::TLM_WRITE_COMMAND);
+    gp.set_address(0);
+    gp.set_data_ptr(bytes.data());
+    gp.set_data_length(static_cast<unsigned>(bytes.size()));
+    gp.set_streaming_width(static_cast<unsigned>(bytes.size()));
+    gp.set_byte_enable_ptr(nullptr);
+    gp.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+    sc_core::sc_time t = sc_core::SC_ZERO_TIME;
+    i_skt->b_transport(gp, t);
+    ++batches;
+  }
+
+  const std::size_t                         batch;
+  const sc_core::sc_time                    window;
+  spsc_ring<lane_obs_packed, ring_size>     ring;
+  std::vector<lane_obs_packed>              out;
+  std::vector<unsigned char>                bytes;
+  tlm::tlm_generic_payload                  gp;
+  sc_core::sc_event                         first_ev, full_ev;
+};
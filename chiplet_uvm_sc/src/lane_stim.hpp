@@ -0,0 +1,155 @@
+#pragma once
+#include <systemc>
+#include <tlm>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "lane_txn.hpp"
+
+// SystemC stand-ins for the UVM side, so the fabric runs without a
+// simulator or UVMC. Bind lane_seq_gen::i_skt where uvmc_connect would
+// otherwise bind a lane_driver_sc::t_skt.
+
+// Equivalent of seq_pkg::lane_seq: each sequence is 16..256 ops, each op
+// goes to a random chiplet_id < n_chiplets, is a write or a read 50/50,
+// with a random word-aligned address and random data. Unlike lane_seq
+// (full 32-bit range unless its addr_window is set through uvm_config_db),
+// addresses stay in [addr_base, addr_base + addr_window), a small window
+// so reads mostly land on words written earlier. Transactions are sent
+// one at a time, blocking, like the SV driver proxy; every completed
+// transaction is published on `ap` (the monitor's view). Error responses are counted and reported as warnings;
+// the caller decides what they mean for the run.
+struct lane_seq_gen : sc_core::sc_module {
+  tlm_utils::simple_initiator_socket<lane_seq_gen> i_skt;  // to lane_driver_sc::t_skt
+  tlm::tlm_analysis_port<lane_txn>                 ap;     // completed transactions
+
+  unsigned      n_chiplets;
+  unsigned      n_seqs;
+  std::uint32_t addr_base;
+  std::uint32_t addr_window;     // bytes, at least one word
+  std::uint64_t sent{0};
+  std::uint64_t errors{0};       // non-OK responses, not published on ap
+
+  SC_HAS_PROCESS(lane_seq_gen);
+  lane_seq_gen(sc_core::sc_module_name nm, unsigned n_chiplets_ = 4,
+               unsigned n_seqs_ = 1, std::uint32_t seed = 1,
+               std::uint32_t addr_base_ = 0, std::uint32_t addr_window_ = 0x400)
+  : sc_module(nm), i_skt("i_skt"), ap("ap"),
+    n_chiplets(n_chiplets_ ? n_chiplets_ : 1), n_seqs(n_seqs_),
+    addr_base(addr_base_ & ~std::uint32_t(3)),
+    addr_window(addr_window_ < 4 ? 4 : addr_window_), rng(seed) {
+    gp.set_extension(&ext);
+    SC_THREAD(run);
+  }
+  ~lane_seq_gen() override { gp.clear_extension(&ext); }
+
+private:
+  void run() {
+    std::uniform_int_distribution<unsigned>      n_ops(16, 256);
+    std::uniform_int_distribution<unsigned>      id(0, n_chiplets - 1);
+    std::uniform_int_distribution<std::uint32_t> word;
+    std::uniform_int_distribution<std::uint32_t> offset(0, addr_window / 4 - 1);
+    std::bernoulli_distribution                  is_write(0.5);
+
+    for (unsigned s = 0; s < n_seqs; ++s) {
+      for (unsigned n = n_ops(rng); n; --n) {
+        ext.chiplet_id = static_cast<std::uint8_t>(id(rng));
+        ext.write      = is_write(rng);
+        ext.addr       = addr_base + offset(rng) * 4;
+        ext.data       = word(rng);
+        transport();
+      }
+    }
+  }
+
+  // Same payload shape the driver builds for a batch record: the word
+  // travels in `buf`, address and routing in the lane_txn extension.
+  void transport() {
+    buf = ext.data;
+    gp.set_command(ext.write ? tlm::TLM_WRITE_COMMAND : tlm::TLM_READ_COMMAND);
+    gp.set_address(ext.addr);
+    gp.set_data_ptr(reinterpret_cast<unsigned char*>(&buf));
+    gp.set_data_length(sizeof(buf));
+    gp.set_streaming_width(sizeof(buf));
+    gp.set_byte_enable_ptr(nullptr);
+    gp.set_dmi_allowed(false);
+    gp.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+
+    sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
+    i_skt->b_transport(gp, delay);
+    wait(delay);
+    ++sent;
+
+    if (gp.is_response_error()) {
+      ++errors;
+      SC_REPORT_WARNING(name(), ("chiplet" + std::to_string(ext.chiplet_id) + ": " +
+                                 gp.get_response_string()).c_str());
+      return;
+    }
+    if (!ext.write) ext.data = buf;
+    ap.write(ext);
+  }
+
+  std::mt19937             rng;
+  tlm::tlm_generic_payload gp;
+  lane_txn                 ext;
+  std::uint32_t            buf{0};
+};
+
+// Initiator that never sends: bound to lane_driver_sc sockets nobody
+// drives in a standalone run (target sockets must be bound).
+struct lane_idle_src : sc_core::sc_module {
+  tlm_utils::simple_initiator_socket<lane_idle_src> i_skt;
+
+  explicit lane_idle_src(sc_core::sc_module_name nm) : sc_module(nm), i_skt("i_skt") {}
+};
+
+// Equivalent of env_pkg::scoreboard: counts writes and reads, and since the
+// chiplets keep real memory it also checks every read against the last
+// write to the same chiplet and address (never-written words read as
+// zero). The check assumes one writer per address, so concurrent
+// generators need disjoint address windows. Mismatches are counted and
+// reported as warnings; the caller decides the exit code.
+struct lane_scoreboard : sc_core::sc_module, tlm::tlm_analysis_if<lane_txn> {
+  std::uint64_t wr_cnt{0};
+  std::uint64_t rd_cnt{0};
+  std::uint64_t mismatches{0};
+
+  explicit lane_scoreboard(sc_core::sc_module_name nm) : sc_module(nm) {}
+
+  void write(const lane_txn& t) override {
+    const std::uint64_t key = (std::uint64_t(t.chiplet_id) << 32) | t.addr;
+    if (t.write) {
+      ++wr_cnt;
+      model[key] = t.data;
+      return;
+    }
+    ++rd_cnt;
+    auto it = model.find(key);
+    const std::uint32_t expect = it == model.end() ? 0 : it->second;
+    if (t.data != expect) {
+      ++mismatches;
+      SC_REPORT_WARNING(name(), ("read mismatch chiplet" + std::to_string(t.chiplet_id) +
+                                 " addr=" + hex(t.addr) + " got=" + hex(t.data) +
+                                 " expect=" + hex(expect)).c_str());
+    }
+  }
+
+  void end_of_simulation() override {
+    SC_REPORT_INFO(name(), ("WR=" + std::to_string(wr_cnt) + " RD=" + std::to_string(rd_cnt) +
+                            " mismatches=" + std::to_string(mismatches)).c_str());
+  }
+
+private:
+  static std::string hex(std::uint32_t v) {
+    char b[11];
+    std::snprintf(b, sizeof(b), "0x%08x", v);
+    return b;
+  }
+
+  std::unordered_map<std::uint64_t, std::uint32_t> model;
+};
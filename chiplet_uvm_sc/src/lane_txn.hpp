@@ -1,13 +1,45 @@
 #pragma once
 #include <systemc>
 #include <tlm>
+// CHIPLET_STANDALONE: plain SystemC build without UVMC (no converter)
+#ifndef CHIPLET_STANDALONE
 #include <uvmc.h>
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
 
-struct lane_txn {
-  sc_dt::sc_uint<32> addr{0};
-  sc_dt::sc_uint<32> data{0};
-  bool               write{false};
-  sc_dt::sc_uint<4>  chiplet_id{0};
+// Fixed-layout image of one lane transaction: plain integers, no padding
+// surprises, safe to memcpy. Vectors of these are what the bulk converters
+// below produce and consume.
+struct lane_txn_packed {
+  std::uint32_t addr;
+  std::uint32_t data;
+  std::uint8_t  write;        // 0 or 1
+  std::uint8_t  chiplet_id;
+  std::int8_t   status;       // tlm_response_status, set when a batch record is forwarded
+  std::uint8_t  rsvd;         // keeps the record 4-byte aligned
+};
+static_assert(std::is_trivially_copyable<lane_txn_packed>::value, "lane_txn_packed must be trivially copyable");
+static_assert(std::is_standard_layout<lane_txn_packed>::value,    "lane_txn_packed must be standard layout");
+static_assert(sizeof(lane_txn_packed) == 12,                       "lane_txn_packed layout changed");
+static_assert(offsetof(lane_txn_packed, addr)       == 0,          "lane_txn_packed layout changed");
+static_assert(offsetof(lane_txn_packed, data)       == 4,          "lane_txn_packed layout changed");
+static_assert(offsetof(lane_txn_packed, write)      == 8,          "lane_txn_packed layout changed");
+static_assert(offsetof(lane_txn_packed, chiplet_id) == 9,          "lane_txn_packed layout changed");
+static_assert(offsetof(lane_txn_packed, status)     == 10,         "lane_txn_packed layout changed");
+
+// Lane transaction, carried on the generic payload as an extension and
+// converted by UVMC on SV<->SC crossings. Fields are native integers so
+// packing streams plain words instead of going through sc_uint<>. The
+// UVMC field order and widths match lane_pkg::lane_txn on the SV side.
+struct lane_txn : tlm::tlm_extension<lane_txn> {
+  std::uint32_t addr{0};
+  std::uint32_t data{0};
+  bool          write{false};
+  std::uint8_t  chiplet_id{0};
 
   template <typename PACKER> void do_pack(PACKER& p) const {
     p << addr << data << write << chiplet_id;
@@ -15,6 +47,50 @@ struct lane_txn {
   template <typename PACKER> void do_unpack(PACKER& p) {
     p >> addr >> data >> write >> chiplet_id;
   }
+
+  lane_txn_packed pack() const {
+    return lane_txn_packed{addr, data, static_cast<std::uint8_t>(write), chiplet_id, 0, 0};
+  }
+  void unpack(const lane_txn_packed& r) {
+    addr       = r.addr;
+    data       = r.data;
+    write      = r.write != 0;
+    chiplet_id = r.chiplet_id;
+  }
+
+  // tlm_extension
+  tlm::tlm_extension_base* clone() const override { return new lane_txn(*this); }
+  void copy_from(const tlm::tlm_extension_base& e) override {
+    const auto& o = static_cast<const lane_txn&>(e);
+    addr = o.addr; data = o.data; write = o.write; chiplet_id = o.chiplet_id;
+  }
 };
 
+// Bulk converters: a whole vector in one call, one pass, no per-field
+// dispatch. `out` is resized, so its storage is reused across calls.
+inline void pack_lane_txns(const std::vector<lane_txn>& in, std::vector<lane_txn_packed>& out) {
+  out.resize(in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) out[i] = in[i].pack();
+}
+
+inline void unpack_lane_txns(const std::vector<lane_txn_packed>& in, std::vector<lane_txn>& out) {
+  out.resize(in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) out[i].unpack(in[i]);
+}
+
+// Raw byte image of a packed vector (e.g. one UVMC byte-array payload)
+inline void packed_to_bytes(const std::vector<lane_txn_packed>& in, std::vector<unsigned char>& out) {
+  out.resize(in.size() * sizeof(lane_txn_packed));
+  if (!in.empty()) std::memcpy(out.data(), in.data(), out.size());
+}
+
+inline bool bytes_to_packed(const unsigned char* p, std::size_t n, std::vector<lane_txn_packed>& out) {
+  if (n % sizeof(lane_txn_packed)) return false;
+  out.resize(n / sizeof(lane_txn_packed));
+  if (n) std::memcpy(out.data(), p, n);
+  return true;
+}
+
+#ifndef CHIPLET_STANDALONE
 UVMC_UTILS_4(lane_txn, addr, data, write, chiplet_id)
+#endif
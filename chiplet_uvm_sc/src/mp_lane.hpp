@@ -1,25 +1,313 @@
 #pragma once
 #include <systemc>
 #include <tlm>
+#include <tlm_utils/multi_passthrough_target_socket.h>
+#include <tlm_utils/multi_passthrough_initiator_socket.h>
+#include <array>
+#include <cstring>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "lane_txn.hpp"
+#include "lane_arbiter.hpp"
+#include "lane_mon.hpp"
 
-// Simple interconnect that routes by chiplet_id to 4 targets
+// Link model shared by every output of the lane
+struct mp_lane_cfg {
+  unsigned              link_bytes = 4;                                   // bytes per beat
+  sc_core::sc_time      beat       = sc_core::sc_time(1, sc_core::SC_NS); // 0 = no link model
+  std::string           arbiter    = "rr";                                // rr | fixed | weighted
+  std::vector<unsigned> weights;                                          // per driver, weighted only
+};
+
+// Interconnect that routes by chiplet_id to any number of targets.
+// Chiplet k must be the k-th target bound to i_skt; any number of drivers
+// may bind to t_skt. IDs with no target bound get TLM_ADDRESS_ERROR_RESPONSE.
+//
+// Both b_transport (LT) and nb_transport (AT) are routed. For AT the lane
+// remembers which driver each open transaction came from, so backward-path
+// phases find their way home.
+//
+// Each output is a link of cfg.link_bytes per beat; a request holds it for
+// ceil(len / link_bytes) beats. LT never waits here: each link keeps the
+// time it is busy until, and a b_transport call takes the link at
+// max(its annotated arrival, busy-until), in call order, with the queueing
+// and hold time added to its delay. The drivers' quantum therefore still
+// applies across the lane. AT requests contend through the configured
+// arbiter and get END_REQ once they have crossed the link, so a busy link
+// back-pressures the driver. Per-link statistics are reported at end of
+// simulation.
+//
+// Every routed transaction is published on mon_ap when it completes (LT:
+// b_transport returns, AT: BEGIN_RESP), with its start time and latency.
+// Publishing is a write() to the subscribers and nothing else; see
+// lane_mon_tap for getting observations across to SV without stalling.
 struct mp_lane : sc_core::sc_module {
-  tlm::tlm_target_socket<>   t_skt;      // from drivers
-  tlm::tlm_initiator_socket<> i_skt[4];  // to chiplets
+  tlm_utils::multi_passthrough_target_socket<mp_lane>    t_skt;  // from drivers
+  tlm_utils::multi_passthrough_initiator_socket<mp_lane> i_skt;  // to chiplets
+  tlm::tlm_analysis_port<lane_obs>                       mon_ap; // completed transactions
 
-  SC_CTOR(mp_lane) : t_skt("t_skt") {
-    for(int i=0;i<4;++i) {
-      std::string n = std::string("i_skt_") + char('0'+i);
-      i_skt[i].init(n.c_str());
-    }
+  std::uint64_t route_errors{0};
+
+  // Queueing delay histogram: bucket 0 is no wait, bucket i > 0 counts
+  // waits in [2^(i-1), 2^i) ns, the last bucket everything above.
+  static constexpr std::size_t hist_buckets = 16;
+
+  struct link_stats {
+    std::uint64_t                             txns{0};
+    std::uint64_t                             beats{0};
+    std::uint64_t                             backpressure{0};   // requests that had to wait
+    sc_core::sc_time                          busy;
+    sc_core::sc_time                          queued;            // total queueing delay
+    std::array<std::uint64_t, hist_buckets>   queue_hist{};
+  };
+
+  SC_HAS_PROCESS(mp_lane);
+  explicit mp_lane(sc_core::sc_module_name nm, const mp_lane_cfg& cfg_ = {})
+  : sc_module(nm), t_skt("t_skt"), i_skt("i_skt"), mon_ap("mon_ap"), cfg(cfg_) {
     t_skt.register_b_transport(this, &mp_lane::b_transport);
+    t_skt.register_nb_transport_fw(this, &mp_lane::nb_transport_fw);
+    i_skt.register_nb_transport_bw(this, &mp_lane::nb_transport_bw);
   }
 
-  void b_transport(tlm::tlm_generic_payload& gp, sc_core::sc_time& delay) {
-    lane_txn* lt = gp.get_extension<lane_txn>();
-    unsigned id = lt ? lt->chiplet_id.to_uint() : 0;
-    if(id>3) id=0;
+  const link_stats& stats(unsigned link) const { return links[link]->stats; }
+
+  void b_transport(int from, tlm::tlm_generic_payload& gp, sc_core::sc_time& delay) {
+    int id = route(gp);
+    if (id < 0) return;
+    const sc_core::sc_time start = sc_core::sc_time_stamp() + delay;
+    if (modeled()) delay = links[id]->occupy(gp, start) - sc_core::sc_time_stamp();
     i_skt[id]->b_transport(gp, delay);
+    observe(gp, from, id, start, sc_core::sc_time_stamp() + delay);
+  }
+
+  tlm::tlm_sync_enum nb_transport_fw(int from, tlm::tlm_generic_payload& gp,
+                                     tlm::tlm_phase& phase, sc_core::sc_time& delay) {
+    int id = route(gp);
+    if (id < 0) {
+      phase = tlm::BEGIN_RESP;
+      return tlm::TLM_COMPLETED;
+    }
+    if (phase == tlm::BEGIN_REQ) {
+      open_[&gp] = open_txn{from, sc_core::sc_time_stamp() + delay};
+      if (modeled()) {
+        links[id]->enqueue_at(request{&gp, from, sc_core::sc_time_stamp() + delay}, delay);
+        return tlm::TLM_ACCEPTED;
+      }
+    }
+    tlm::tlm_sync_enum s = i_skt[id]->nb_transport_fw(gp, phase, delay);
+    if (s == tlm::TLM_COMPLETED || (s == tlm::TLM_UPDATED && phase == tlm::BEGIN_RESP)) {
+      auto it = open_.find(&gp);
+      if (it != open_.end()) observe(gp, from, id, it->second.start, sc_core::sc_time_stamp() + delay);
+    }
+    if (s == tlm::TLM_COMPLETED || phase == tlm::END_RESP) open_.erase(&gp);
+    return s;
+  }
+
+  tlm::tlm_sync_enum nb_transport_bw(int to, tlm::tlm_generic_payload& gp,
+                                     tlm::tlm_phase& phase, sc_core::sc_time& delay) {
+    auto it = open_.find(&gp);
+    if (it == open_.end()) {
+      SC_REPORT_ERROR(name(), "backward-path phase for a transaction the lane never forwarded");
+      return tlm::TLM_COMPLETED;
+    }
+    const int from = it->second.from;
+    if (phase == tlm::BEGIN_RESP) observe(gp, from, to, it->second.start, sc_core::sc_time_stamp() + delay);
+    tlm::tlm_sync_enum s = t_skt[from]->nb_transport_bw(gp, phase, delay);
+    if (s == tlm::TLM_COMPLETED) open_.erase(it);
+    return s;
+  }
+
+protected:
+  void end_of_elaboration() override {
+    if (!modeled()) return;
+    for (unsigned k = 0; k < i_skt.size(); ++k) {
+      links.push_back(std::make_unique<link>(*this, k));
+      link* l = links.back().get();
+      const std::string n = "link" + std::to_string(k);
+      sc_core::sc_spawn([l] { l->run(); },   (n + "_arb").c_str());
+      sc_core::sc_spawn([l] { l->admit(); }, (n + "_admit").c_str());
+    }
+  }
+
+  void end_of_simulation() override {
+    const double now = sc_core::sc_time_stamp().to_seconds();
+    for (unsigned k = 0; k < links.size(); ++k) {
+      const link_stats& s = links[k]->stats;
+      std::string msg = "link" + std::to_string(k) +
+                        ": txns=" + std::to_string(s.txns) +
+                        " beats=" + std::to_string(s.beats) +
+                        " util=" + std::to_string(now > 0 ? 100.0 * s.busy.to_seconds() / now : 0.0) + "%" +
+                        " backpressure=" + std::to_string(s.backpressure) +
+                        " avg_queue=" + (s.txns ? (s.queued / static_cast<double>(s.txns)).to_string()
+                                                : std::string("0 s")) +
+                        " queue_hist_ns[0,1,2,4,..]=";
+      for (std::size_t b = 0; b < hist_buckets; ++b) {
+        msg += (b ? "," : "") + std::to_string(s.queue_hist[b]);
+      }
+      SC_REPORT_INFO(name(), msg.c_str());
+    }
+    if (route_errors) {
+      SC_REPORT_WARNING(name(), ("route errors: " + std::to_string(route_errors)).c_str());
+    }
   }
+
+private:
+  struct request {
+    tlm::tlm_generic_payload* gp;
+    int                       from;
+    sc_core::sc_time          arrival;
+  };
+
+  // One output link: busy-until time for LT, and for AT a queue of waiting
+  // requests, an arbiter and a process that grants the link one request at
+  // a time.
+  struct link {
+    link(mp_lane& lane_, unsigned id_)
+    : lane(lane_), id(id_), arb(make_lane_arbiter(lane_.cfg.arbiter, lane_.cfg.weights)) {}
+
+    // LT: the request arriving at `arrival` takes the link as soon as it is
+    // free; returns when it has crossed
+    sc_core::sc_time occupy(const tlm::tlm_generic_payload& gp, const sc_core::sc_time& arrival) {
+      const sc_core::sc_time grant = busy_until > arrival ? busy_until : arrival;
+      const unsigned beats = beats_for(gp);
+      const sc_core::sc_time hold = lane.cfg.beat * static_cast<double>(beats);
+      if (grant > arrival) ++stats.backpressure;
+      record(grant - arrival, beats, hold);
+      busy_until = grant + hold;
+      return busy_until;
+    }
+
+    unsigned beats_for(const tlm::tlm_generic_payload& gp) const {
+      const unsigned len   = gp.get_data_length();
+      const unsigned bytes = lane.cfg.link_bytes ? lane.cfg.link_bytes : 1;
+      return len ? (len + bytes - 1) / bytes : 1;
+    }
+
+    void enqueue(const request& r) {
+      if (busy_until > sc_core::sc_time_stamp() || !queue.empty()) ++stats.backpressure;
+      queue.push_back(r);
+      req_ev.notify(sc_core::SC_ZERO_TIME);   // same-time arrivals arbitrate together
+    }
+
+    // AT requests arrive `delay` in the future
+    void enqueue_at(const request& r, const sc_core::sc_time& delay) {
+      late.push_back(r);
+      late_ev.notify(delay);
+    }
+
+    void run() {
+      std::vector<int> who;
+      while (true) {
+        while (queue.empty()) sc_core::wait(req_ev);
+        if (busy_until > sc_core::sc_time_stamp()) {
+          sc_core::wait(busy_until - sc_core::sc_time_stamp());
+          continue;   // arbitrate among everyone queued by then
+        }
+
+        who.clear();
+        for (const auto& r : queue) who.push_back(r.from);
+        const std::size_t win = arb->pick(who);
+        request r = queue[win];
+        queue.erase(queue.begin() + static_cast<std::ptrdiff_t>(win));
+
+        const unsigned beats = beats_for(*r.gp);
+        const sc_core::sc_time hold = lane.cfg.beat * static_cast<double>(beats);
+        record(sc_core::sc_time_stamp() - r.arrival, beats, hold);
+
+        busy_until = sc_core::sc_time_stamp() + hold;
+        sc_core::wait(hold);
+        forward_at(r);
+      }
+    }
+
+    // Moves AT requests into the queue once their annotated time is reached
+    void admit() {
+      while (true) {
+        sc_core::wait(late_ev);
+        const sc_core::sc_time now = sc_core::sc_time_stamp();
+        for (auto it = late.begin(); it != late.end();) {
+          if (it->arrival <= now) { enqueue(*it); it = late.erase(it); }
+          else { late_ev.notify(it->arrival - now); ++it; }
+        }
+      }
+    }
+
+    // The request has crossed the link: hand it to the chiplet and tell the
+    // driver its request phase is over.
+    void forward_at(const request& r) {
+      tlm::tlm_phase     phase = tlm::BEGIN_REQ;
+      sc_core::sc_time   t     = sc_core::SC_ZERO_TIME;
+      tlm::tlm_sync_enum s     = lane.i_skt[id]->nb_transport_fw(*r.gp, phase, t);
+      if (s == tlm::TLM_ACCEPTED) return;   // chiplet sends END_REQ itself
+      if (s == tlm::TLM_COMPLETED) phase = tlm::BEGIN_RESP;
+      lane.nb_transport_bw(static_cast<int>(id), *r.gp, phase, t);
+    }
+
+    void record(const sc_core::sc_time& waited, unsigned beats, const sc_core::sc_time& hold) {
+      ++stats.txns;
+      stats.beats  += beats;
+      stats.busy   += hold;
+      stats.queued += waited;
+      std::uint64_t ns = static_cast<std::uint64_t>(waited.to_seconds() * 1e9);
+      std::size_t b = 0;
+      while (ns && b < hist_buckets - 1) { ns >>= 1; ++b; }
+      ++stats.queue_hist[b];
+    }
+
+    mp_lane&                      lane;
+    unsigned                      id;
+    std::unique_ptr<lane_arbiter> arb;
+    std::deque<request>           queue;
+    std::vector<request>          late;     // AT, not yet arrived
+    sc_core::sc_event             req_ev, late_ev;
+    sc_core::sc_time              busy_until;
+    link_stats                    stats;
+  };
+
+  struct open_txn {
+    int              from;
+    sc_core::sc_time start;
+  };
+
+  void observe(const tlm::tlm_generic_payload& gp, int from, int to,
+               const sc_core::sc_time& start, const sc_core::sc_time& end) {
+    lane_obs o;
+    if (const lane_txn* lt = gp.get_extension<lane_txn>()) {
+      o.txn.copy_from(*lt);
+    } else {
+      o.txn.addr       = static_cast<std::uint32_t>(gp.get_address());
+      o.txn.write      = gp.is_write();
+      o.txn.chiplet_id = static_cast<std::uint8_t>(to);
+      if (gp.get_data_ptr() && gp.get_data_length() >= sizeof(o.txn.data))
+        std::memcpy(&o.txn.data, gp.get_data_ptr(), sizeof(o.txn.data));
+    }
+    o.from    = static_cast<unsigned>(from);
+    o.to      = static_cast<unsigned>(to);
+    o.start   = start;
+    o.latency = end > start ? end - start : sc_core::SC_ZERO_TIME;
+    o.status  = gp.get_response_status();
+    mon_ap.write(o);
+  }
+
+  bool modeled() const { return cfg.beat != sc_core::SC_ZERO_TIME; }
+
+  // Target index for gp, or -1 with the response status set
+  int route(tlm::tlm_generic_payload& gp) {
+    lane_txn* lt = gp.get_extension<lane_txn>();
+    unsigned id = lt ? lt->chiplet_id : 0;   // untagged traffic goes to chiplet 0
+    if (id >= i_skt.size()) {
+      ++route_errors;
+      gp.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+      return -1;
+    }
+    return static_cast<int>(id);
+  }
+
+  mp_lane_cfg                                             cfg;
+  std::vector<std::unique_ptr<link>>                      links;
+  std::unordered_map<tlm::tlm_generic_payload*, open_txn> open_;   // AT: gp -> driver, start
 };
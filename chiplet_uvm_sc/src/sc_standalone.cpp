@@ -0,0 +1,80 @@
+// The chiplet fabric as a plain SystemC executable: no simulator, no UVMC.
+// SystemC stimulus (lane_stim.hpp) stands in for the UVM sequence, driver
+// proxy and scoreboard, so the fabric can be run and timed on its own.
+//
+//   chiplet_standalone [sc_top plusargs] [+streams=<n>] [+seqs=<n>] [+seed=<s>]
+//
+// All sc_top plusargs apply (+chiplets, +mode, +quantum_ns, +beat_ns, ...).
+//   +streams=<n>  lane drivers with a generator on them (default 1, like
+//                 the UVM test which drives lane0 only; capped at +chiplets)
+//   +seqs=<n>     lane_seq sequences per generator (default 1)
+//   +seed=<s>     base random seed, generator k uses seed + k (default 1)
+//   +window=<b>   address window per generator in bytes (default 0x400);
+//                 generator k uses [k * window, (k + 1) * window)
+// Mismatches and error responses are reported as warnings, the summary is
+// always printed, and the run exits non-zero if there were any.
+
+#include <systemc>
+#include <tlm_utils/tlm_quantumkeeper.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "sc_top.hpp"
+#include "lane_stim.hpp"
+
+using namespace sc_core;
+
+int sc_main(int argc, char* argv[]) {
+  const sc_top_cfg cfg = sc_top_cfg::from_args(argc, argv);
+  unsigned      streams = 1;
+  unsigned      seqs    = 1;
+  std::uint32_t seed    = 1;
+  std::uint32_t window  = 0x400;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    if      (!std::strncmp(a, "+streams=", 9)) streams = std::strtoul(a + 9, nullptr, 0);
+    else if (!std::strncmp(a, "+seqs=", 6))    seqs    = std::strtoul(a + 6, nullptr, 0);
+    else if (!std::strncmp(a, "+seed=", 6))    seed    = std::strtoul(a + 6, nullptr, 0);
+    else if (!std::strncmp(a, "+window=", 8))  window  = std::strtoul(a + 8, nullptr, 0);
+  }
+  tlm_utils::tlm_quantumkeeper::set_global_quantum(sc_time(cfg.quantum_ns, SC_NS));
+
+  sc_top          top("top", cfg);
+  lane_scoreboard scb("scb");
+  std::vector<std::unique_ptr<lane_seq_gen>> gens;
+  for (unsigned k = 0; k < streams && k < top.drv.size(); ++k) {
+    gens.push_back(std::make_unique<lane_seq_gen>(("gen" + std::to_string(k)).c_str(),
+                                                  cfg.n_chiplets, seqs, seed + k,
+                                                  k * window, window));
+    gens.back()->i_skt.bind(top.drv[k]->t_skt);
+    gens.back()->ap.bind(scb);
+  }
+  // Every driver socket without stimulus gets an idle initiator
+  std::vector<std::unique_ptr<lane_idle_src>> idle;
+  for (unsigned k = 0; k < top.drv.size(); ++k) {
+    const std::string ks = std::to_string(k);
+    if (k >= gens.size()) {
+      idle.push_back(std::make_unique<lane_idle_src>(("idle_t" + ks).c_str()));
+      idle.back()->i_skt.bind(top.drv[k]->t_skt);
+    }
+    idle.push_back(std::make_unique<lane_idle_src>(("idle_b" + ks).c_str()));
+    idle.back()->i_skt.bind(top.drv[k]->b_skt);
+  }
+
+  const auto t0 = std::chrono::steady_clock::now();
+  sc_start();
+  const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  std::uint64_t sent = 0, errors = 0;
+  for (auto& g : gens) { sent += g->sent; errors += g->errors; }
+  std::cout << "[BENCH] chiplet fabric, streams=" << gens.size() << " txns=" << sent
+            << " sim=" << sc_time_stamp() << " wall=" << wall << " s"
+            << " (" << (wall > 0 ? sent / wall : 0.0) << " txn/s)\n";
+  if (scb.mismatches || errors)
+    std::cout << "[BENCH] FAIL: " << scb.mismatches << " mismatches, " << errors << " error responses\n";
+  return (scb.mismatches || errors) ? 1 : 0;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <systemc>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lane_txn.hpp"
+#include "mp_lane.hpp"
+#include "chiplet.hpp"
+#include "drivers.hpp"
+
+// Package configuration. Set from plusargs so the same names work on the
+// simulator command line for both the SV and SystemC sides:
+//   +chiplets=<n>      number of chiplets and lane drivers (default 4)
+//   +quantum_ns=<t>    global quantum for the loosely-timed lane drivers
+//                      (default 0 = synchronize after every transaction)
+//   +channel=<prefix>  UVMC channel prefix, driver k uses <prefix><k> and
+//                      <prefix><k>_batch
+//   +mode=lt|at        blocking (default) or non-blocking lane protocol
+//   +outstanding=<n>   AT: transactions in flight per driver (default 4)
+//   +link_bytes=<n>    lane link width in bytes per beat (default 4)
+//   +beat_ns=<t>       time per beat (default 1, 0 disables the link model)
+//   +arb=rr|fixed|weighted   link arbitration across drivers (default rr)
+//   +weights=<w0,w1,..>      per-driver weights for +arb=weighted
+//   +mon_batch=<n>     lane observations per crossing to the SV monitor (default 64)
+//   +mon_window_ns=<t> send a partial monitor batch after t (default 100)
+struct sc_top_cfg {
+  unsigned    n_chiplets  = 4;
+  double      quantum_ns  = 0.0;
+  std::string channel     = "lane";
+  lane_mode   mode        = lane_mode::lt;
+  unsigned    outstanding = 4;
+  mp_lane_cfg lane;
+  unsigned    mon_batch     = 64;
+  double      mon_window_ns = 100.0;
+
+  static sc_top_cfg from_args(int argc, char* argv[]) {
+    sc_top_cfg c;
+    for (int i = 1; i < argc; ++i) {
+      const char* a = argv[i];
+      if      (!std::strncmp(a, "+chiplets=", 10))    c.n_chiplets  = std::strtoul(a + 10, nullptr, 0);
+      else if (!std::strncmp(a, "+quantum_ns=", 12))  c.quantum_ns  = std::strtod(a + 12, nullptr);
+      else if (!std::strncmp(a, "+channel=", 9))      c.channel     = a + 9;
+      else if (!std::strcmp(a, "+mode=at"))           c.mode        = lane_mode::at;
+      else if (!std::strcmp(a, "+mode=lt"))           c.mode        = lane_mode::lt;
+      else if (!std::strncmp(a, "+outstanding=", 13)) c.outstanding = std::strtoul(a + 13, nullptr, 0);
+      else if (!std::strncmp(a, "+link_bytes=", 12))  c.lane.link_bytes = std::strtoul(a + 12, nullptr, 0);
+      else if (!std::strncmp(a, "+beat_ns=", 9))      c.lane.beat = sc_core::sc_time(std::strtod(a + 9, nullptr), sc_core::SC_NS);
+      else if (!std::strncmp(a, "+arb=", 5))          c.lane.arbiter = a + 5;
+      else if (!std::strncmp(a, "+mon_batch=", 11))    c.mon_batch     = std::strtoul(a + 11, nullptr, 0);
+      else if (!std::strncmp(a, "+mon_window_ns=", 15)) c.mon_window_ns = std::strtod(a + 15, nullptr);
+      else if (!std::strncmp(a, "+weights=", 9)) {
+        for (const char* p = a + 9; *p; ) {
+          char* end;
+          c.lane.weights.push_back(std::strtoul(p, &end, 0));
+          if (*end != ',') break;
+          p = end + 1;
+        }
+      }
+    }
+    return c;
+  }
+};
+
+// The chiplet fabric: n lane drivers into one mp_lane, out to n chiplets.
+// Drivers' t_skt/b_skt are left for the caller to bind, to UVMC channels
+// (sc_top.cpp) or to SystemC stimulus (sc_standalone.cpp).
+struct sc_top : sc_core::sc_module {
+  std::vector<std::unique_ptr<lane_driver_sc>> drv;
+  mp_lane                                      lane;
+  std::vector<std::unique_ptr<chiplet>>        chiplets;
+
+  SC_HAS_PROCESS(sc_top);
+
+  sc_top(sc_core::sc_module_name nm, const sc_top_cfg& cfg)
+  : sc_module(nm), lane("lane", cfg.lane)
+  {
+    // mp_lane routes chiplet_id k to its k-th initiator binding, so the
+    // chiplets are bound in id order.
+    for (unsigned k = 0; k < cfg.n_chiplets; ++k) {
+      const std::string ks = std::to_string(k);
+
+      drv.push_back(std::make_unique<lane_driver_sc>(("drv" + ks).c_str(),
+                                                     cfg.mode, cfg.outstanding));
+      chiplets.push_back(std::make_unique<chiplet>(("chiplet" + ks).c_str(), k));
+
+      // Driver upstream into the lane, lane out to the chiplet
+      drv.back()->i_skt.bind(lane.t_skt);
+      lane.i_skt.bind(chiplets.back()->t_skt);
+    }
+  }
+};
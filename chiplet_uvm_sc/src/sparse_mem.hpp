@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+// Sparse byte-addressable memory over a 32-bit address space. Storage is
+// a table of 4 KiB pages allocated on first write, so the footprint is
+// proportional to the pages actually written. Bytes never written read as
+// zero without allocating. Accesses may cross page boundaries and wrap at
+// 4 GiB.
+class sparse_mem {
+public:
+  static constexpr unsigned      page_bits = 12;
+  static constexpr std::uint32_t page_size = 1u << page_bits;
+
+  void read(std::uint32_t addr, unsigned char* dst, std::size_t len) const {
+    while (len) {
+      const std::uint32_t off = addr & (page_size - 1);
+      const std::size_t   n   = chunk(off, len);
+      if (const unsigned char* p = find(addr >> page_bits)) std::memcpy(dst, p + off, n);
+      else                                                  std::memset(dst, 0, n);
+      addr += static_cast<std::uint32_t>(n); dst += n; len -= n;
+    }
+  }
+
+  void write(std::uint32_t addr, const unsigned char* src, std::size_t len) {
+    while (len) {
+      const std::uint32_t off = addr & (page_size - 1);
+      const std::size_t   n   = chunk(off, len);
+      std::memcpy(touch(addr >> page_bits) + off, src, n);
+      addr += static_cast<std::uint32_t>(n); src += n; len -= n;
+    }
+  }
+
+  std::size_t pages() const { return pages_.size(); }
+  std::size_t bytes_allocated() const { return pages_.size() * std::size_t(page_size); }
+
+private:
+  static std::size_t chunk(std::uint32_t off, std::size_t len) {
+    const std::size_t room = page_size - off;
+    return len < room ? len : room;
+  }
+
+  // Last page looked up is cached: streams of accesses mostly stay in one page
+  const unsigned char* find(std::uint32_t pn) const {
+    if (last_ && last_pn_ == pn) return last_;
+    auto it = pages_.find(pn);
+    if (it == pages_.end()) return nullptr;
+    last_pn_ = pn;
+    last_    = it->second.get();
+    return last_;
+  }
+
+  unsigned char* touch(std::uint32_t pn) {
+    if (last_ && last_pn_ == pn) return last_;
+    auto& p = pages_[pn];
+    if (!p) p.reset(new unsigned char[page_size]());
+    last_pn_ = pn;
+    last_    = p.get();
+    return last_;
+  }
+
+  std::unordered_map<std::uint32_t, std::unique_ptr<unsigned char[]>> pages_;
+  mutable std::uint32_t  last_pn_{0};
+  mutable unsigned char* last_{nullptr};
+};
@@ -2,23 +2,120 @@ package drv_pkg;
   import uvm_pkg::*; `include "uvm_macros.svh"
   import lane_pkg::*; import uvmc_pkg::*;
 
+  // Items go to SystemC one per crossing on <ch>, or, with batch_size > 1,
+  // gathered into one generic payload on <ch>_batch. A batch is flushed
+  // when it holds batch_size items or batch_window after its first item
+  // (0: as soon as the sequencer has nothing more to give). Batched items
+  // are posted: item_done is called when the item is queued, and read data
+  // is written back into the item when its batch returns. While a batch is
+  // pending the driver holds a run-phase objection, so the phase cannot end
+  // before the batch has crossed and its records have been checked.
   class lane_driver extends uvm_driver #(lane_txn);
     `uvm_component_utils(lane_driver)
-    uvm_tlm_b_initiator_socket #(lane_txn) iport;
-    function new(string n, uvm_component p); super.new(n,p); iport=new("iport", this); endfunction
+    uvm_tlm_b_initiator_socket #(lane_txn)                iport;
+    uvm_tlm_b_initiator_socket #(uvm_tlm_generic_payload) bport;
+
+    int unsigned batch_size   = 1;
+    time         batch_window = 0;
+
+    // Wire layout of one record, matches lane_txn_packed on the SC side.
+    // Byte 10 comes back holding the record's tlm_response_status.
+    localparam int REC_BYTES = 12;
+
+    protected lane_txn  pending[$];
+    protected time      first_t;
+    protected uvm_phase run_ph;   // holds the objection for pending items
+
+    function new(string n, uvm_component p); super.new(n,p); iport=new("iport", this); bport=new("bport", this); endfunction
+
+    function void build_phase(uvm_phase p);
+      super.build_phase(p);
+      void'(uvm_config_db#(int unsigned)::get(this, "", "batch_size", batch_size));
+      void'(uvm_config_db#(time)::get(this, "", "batch_window", batch_window));
+    endfunction
 
     function void connect_phase(uvm_phase p);
       string ch;
       if(!uvm_config_db#(string)::get(this, "", "uvmc_channel", ch)) ch = "lane0";
       uvmc_tlm2#(lane_txn)::connect(iport, ch);
+      uvmc_tlm2#(uvm_tlm_generic_payload)::connect(bport, {ch, "_batch"});
     endfunction
 
     task run_phase(uvm_phase p);
-      lane_txn t; forever begin
-        seq_item_port.get_next_item(t);
-        iport.transport(t);
-        seq_item_port.item_done();
+      lane_txn t;
+      run_ph = p;
+      if (batch_size <= 1) begin
+        forever begin
+          seq_item_port.get_next_item(t);
+          iport.transport(t);
+          seq_item_port.item_done();
+        end
+      end
+
+      forever begin
+        if (pending.size() == 0) begin
+          seq_item_port.get_next_item(t);
+          queue_item(t);
+        end else begin
+          seq_item_port.try_next_item(t);
+          if (t != null)                             queue_item(t);
+          else if ($time - first_t >= batch_window)  flush();
+          else                                       #(first_t + batch_window - $time);
+        end
+        if (pending.size() >= batch_size) flush();
+      end
+    endtask
+
+    protected function void queue_item(lane_txn t);
+      if (pending.size() == 0) begin
+        first_t = $time;
+        run_ph.raise_objection(this, "batch pending");
+      end
+      pending.push_back(t);
+      seq_item_port.item_done();
+    endfunction
+
+    // One crossing for the whole batch
+    protected task flush();
+      uvm_tlm_generic_payload gp = new("batch");
+      uvm_tlm_time            delay = new("delay");
+      byte unsigned           bytes[];
+      bytes = new[pending.size() * REC_BYTES];
+      foreach (pending[i]) begin
+        int b = i * REC_BYTES;
+        for (int k = 0; k < 4; k++) begin
+          bytes[b + k]     = pending[i].addr[8*k +: 8];
+          bytes[b + 4 + k] = pending[i].data[8*k +: 8];
+        end
+        bytes[b + 8]  = pending[i].write;
+        bytes[b + 9]  = pending[i].chiplet_id;
+        bytes[b + 10] = 0;   // status, filled in by SystemC
+        bytes[b + 11] = 0;
+      end
+      gp.set_command(UVM_TLM_WRITE_COMMAND);
+      gp.set_address(0);
+      gp.set_data(bytes);
+      gp.set_data_length(bytes.size());
+      gp.set_streaming_width(bytes.size());
+      bport.b_transport(gp, delay);
+
+      if (gp.is_response_error())
+        `uvm_error("BATCH", $sformatf("batch of %0d failed: %s", pending.size(), gp.get_response_string()))
+      gp.get_data(bytes);
+      foreach (pending[i]) begin
+        byte status = bytes[i * REC_BYTES + 10];
+        if (status != 1) begin   // TLM_OK_RESPONSE
+          // 0: never forwarded (the batch failed as a whole, reported above)
+          if (status != 0)
+            `uvm_error("BATCH", $sformatf("%s chiplet%0d addr=%08h failed with status %0d",
+                       pending[i].write ? "write" : "read", pending[i].chiplet_id, pending[i].addr, status))
+          continue;
+        end
+        if (!pending[i].write)
+          for (int k = 0; k < 4; k++) pending[i].data[8*k +: 8] = bytes[i * REC_BYTES + 4 + k];
       end
+      pending.delete();
+      run_ph.drop_objection(this, "batch done");
     endtask
   endclass
 endpackage
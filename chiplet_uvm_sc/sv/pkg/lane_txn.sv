@@ -6,7 +6,7 @@ package lane_pkg;
     rand bit [31:0] addr;
     rand bit [31:0] data;
     rand bit        write;
-    rand bit [3:0]  chiplet_id;
+    rand bit [7:0]  chiplet_id;
 
     `uvm_object_utils_begin(lane_txn)
       `uvm_field_int(addr,      UVM_ALL_ON)
@@ -2,20 +2,51 @@ package mon_pkg;
   import uvm_pkg::*; `include "uvm_macros.svh"
   import lane_pkg::*; import uvmc_pkg::*;
 
+  // Receives lane observations from the SystemC monitor tap (lane_mon_tap),
+  // several per crossing: one generic payload of lane_obs_packed records.
+  // Each record is rebuilt as a lane_txn and written to ap.
   class lane_monitor extends uvm_component;
     `uvm_component_utils(lane_monitor)
     uvm_analysis_port #(lane_txn) ap;
-    uvm_tlm_b_target_socket #(lane_txn) tport;
+    uvm_tlm_b_target_socket #(lane_monitor, uvm_tlm_generic_payload) tport;
 
-    function new(string n, uvm_component p); super.new(n,p); ap=new("ap",this); tport=new("tport",this); endfunction
+    // Wire layout of one record, matches lane_obs_packed on the SC side
+    localparam int REC_BYTES = 32;
+
+    function new(string n, uvm_component p); super.new(n,p); ap=new("ap",this); tport=new("tport",this,this); endfunction
     function void connect_phase(uvm_phase p);
       string ch;
       if(!uvm_config_db#(string)::get(this, "", "uvmc_mon_channel", ch)) ch="mon";
-      uvmc_tlm2#(lane_txn)::connect(tport, ch);
+      uvmc_tlm2#(uvm_tlm_generic_payload)::connect(tport, ch);
     endfunction
 
-    virtual function void b_transport(ref lane_txn t, uvm_tlm_time delay);
-      ap.write(t);
-    endfunction
+    task b_transport(uvm_tlm_generic_payload gp, uvm_tlm_time delay);
+      byte unsigned bytes[];
+      gp.get_data(bytes);
+      if (bytes.size() % REC_BYTES)
+        `uvm_error("MON", $sformatf("batch of %0d bytes is not whole records", bytes.size()))
+      for (int b = 0; b + REC_BYTES <= bytes.size(); b += REC_BYTES) begin
+        lane_txn         t = lane_txn::type_id::create("t");
+        byte             status;
+        longint unsigned start_ps = 0, latency_ps = 0;
+        for (int k = 0; k < 4; k++) begin
+          t.addr[8*k +: 8] = bytes[b + k];
+          t.data[8*k +: 8] = bytes[b + 4 + k];
+        end
+        t.write      = bytes[b + 8];
+        t.chiplet_id = bytes[b + 9];
+        status       = bytes[b + 13];
+        for (int k = 0; k < 8; k++) begin
+          start_ps[8*k +: 8]   = bytes[b + 16 + k];
+          latency_ps[8*k +: 8] = bytes[b + 24 + k];
+        end
+        if (status != 1)   // TLM_OK_RESPONSE
+          `uvm_warning("MON", $sformatf("chiplet%0d addr=%08h completed with status %0d", t.chiplet_id, t.addr, status))
+        `uvm_info("MON", $sformatf("drv%0d -> chiplet%0d at %0d ps, latency %0d ps",
+                   bytes[b + 12], t.chiplet_id, start_ps, latency_ps), UVM_HIGH)
+        ap.write(t);
+      end
+      gp.set_response_status(UVM_TLM_OK_RESPONSE);
+    endtask
   endclass
 endpackage
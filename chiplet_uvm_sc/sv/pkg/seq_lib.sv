@@ -5,6 +5,8 @@ package seq_pkg;
   class lane_seq extends uvm_sequence #(lane_txn);
     `uvm_object_utils(lane_seq)
     rand int unsigned n_ops = 64;
+    int unsigned      n_chiplets = 4;   // ids 0..n_chiplets-1 exist on the SC side
+    int unsigned      addr_window = 0;  // opt-in: addr < addr_window; 0 = full 32-bit range
     constraint c_n { n_ops inside {[16:256]}; }
     function new(string name="lane_seq"); super.new(name); endfunction
 
@@ -13,9 +15,10 @@ package seq_pkg;
       repeat (n_ops) begin
         t = lane_txn::type_id::create("t");
         assert(t.randomize() with {
-          chiplet_id inside {0,1,2,3};
+          chiplet_id < n_chiplets;
           write dist {1:=50, 0:=50};
           addr[1:0]==0;
+          addr_window == 0 || addr < addr_window;
         });
         start_item(t); finish_item(t);
       end
@@ -32,6 +35,8 @@ package seq_pkg;
     endfunction
     task run_phase(uvm_phase p);
       lane_seq s = lane_seq::type_id::create("s");
+      void'(uvm_config_db#(int unsigned)::get(this, "", "n_chiplets", s.n_chiplets));
+      void'(uvm_config_db#(int unsigned)::get(this, "", "addr_window", s.addr_window));
       p.raise_objection(this);
       s.start(seqr);
       p.drop_objection(this);
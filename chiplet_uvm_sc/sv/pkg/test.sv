@@ -9,10 +9,19 @@ package test_pkg;
     function new(string n, uvm_component p); super.new(n,p); endfunction
 
     function void build_phase(uvm_phase p);
+      int unsigned n_chiplets = 4;
+      int unsigned batch = 1, window_ns = 0;
+      void'($value$plusargs("chiplets=%d", n_chiplets));   // same plusarg as the SC side
+      uvm_config_db#(int unsigned)::set(this, "*", "n_chiplets", n_chiplets);
       env = chiplet_env::type_id::create("env", this);
       scb = scoreboard ::type_id::create("scb", this);
       env.analysis_export.connect(scb.imp);
       uvm_config_db#(string)::set(this, "env.drv", "uvmc_channel", "lane0");
+      // +batch=<n> +batch_window_ns=<t>: batch driver items across the SV/SC boundary
+      void'($value$plusargs("batch=%d", batch));
+      void'($value$plusargs("batch_window_ns=%d", window_ns));
+      uvm_config_db#(int unsigned)::set(this, "env.drv", "batch_size", batch);
+      uvm_config_db#(time)::set(this, "env.drv", "batch_window", window_ns * 1ns);
       uvm_config_db#(string)::set(this, "env.mon", "uvmc_mon_channel", "mon");
     endfunction
 
@@ -1,6 +1,7 @@
 #include "gpio_axi_lite.h"
+#include <cstring>
 
-gpio_axi_lite::gpio_axi_lite(sc_module_name name) : sc_module(name) {
+gpio_axi_lite::gpio_axi_lite(sc_module_name name) : sc_module(name), tlm_skt("tlm_skt"), tlm_latency(SC_ZERO_TIME) {
     // Initialize AXI handshake signals
     S_AXI_AWREADY.write(true);
     S_AXI_WREADY.write(true);
@@ -11,10 +12,16 @@ gpio_axi_lite::gpio_axi_lite(sc_module_name name) : sc_module(name) {
     S_AXI_RVALID.write(false);
 
     // Initialize GPIO registers
+    data_val = 0;
+    dir_val = 0;
     reg_data.write(0);
     reg_dir.write(0);
     gpio_out.write(0);
     gpio_oe.write(0);
+    memset(dmi_regs, 0, sizeof(dmi_regs));
+
+    tlm_skt.register_b_transport(this, &gpio_axi_lite::b_transport);
+    tlm_skt.register_get_direct_mem_ptr(this, &gpio_axi_lite::get_direct_mem_ptr);
 
     // Register processes with clock
     SC_METHOD(write_process);
@@ -25,6 +32,13 @@ gpio_axi_lite::gpio_axi_lite(sc_module_name name) : sc_module(name) {
 
     SC_METHOD(output_process);
     sensitive << reg_data << reg_dir;
+
+    SC_METHOD(mirror_process);
+    sensitive << gpio_in;
+
+    SC_METHOD(update_process);
+    sensitive << reg_update;
+    dont_initialize();
 }
 
 gpio_axi_lite::~gpio_axi_lite() {
@@ -34,8 +48,9 @@ gpio_axi_lite::~gpio_axi_lite() {
 void gpio_axi_lite::write_process() {
     // Reset check
     if (!S_AXI_ARESETN.read()) {
-        reg_data.write(0);
-        reg_dir.write(0);
+        data_val = 0;
+        dir_val = 0;
+        regs_changed();
         S_AXI_BVALID.write(false);
         return;
     }
@@ -51,35 +66,7 @@ void gpio_axi_lite::write_process() {
         sc_uint<C_S_AXI_DATA_WIDTH> data = S_AXI_WDATA.read();
         sc_uint<C_S_AXI_DATA_WIDTH/8> strb = S_AXI_WSTRB.read();
 
-        if (addr == 0x0) {
-            // Write to data register (gpio_out)
-            sc_uint<GPIO_WIDTH> current_data = reg_data.read();
-            for (int i = 0; i < C_S_AXI_DATA_WIDTH / 8; i++) {
-                if (strb[i]) {
-                    // Replace 8 bits at position i*8
-                    for (int j = 0; j < 8; j++) {
-                        if (i * 8 + j < GPIO_WIDTH) {
-                            current_data[i * 8 + j] = data[i * 8 + j];
-                        }
-                    }
-                }
-            }
-            reg_data.write(current_data);
-        } else if (addr == 0x4) {
-            // Write to direction register
-            sc_uint<GPIO_WIDTH> current_dir = reg_dir.read();
-            for (int i = 0; i < C_S_AXI_DATA_WIDTH / 8; i++) {
-                if (strb[i]) {
-                    // Replace 8 bits at position i*8
-                    for (int j = 0; j < 8; j++) {
-                        if (i * 8 + j < GPIO_WIDTH) {
-                            current_dir[i * 8 + j] = data[i * 8 + j];
-                        }
-                    }
-                }
-            }
-            reg_dir.write(current_dir);
-        }
+        write_reg(addr, data, strb);
 
         // Assert write response valid
         S_AXI_BVALID.write(true);
@@ -103,19 +90,7 @@ void gpio_axi_lite::read_process() {
 
     if (ar_valid && ar_ready) {
         sc_uint<C_S_AXI_ADDR_WIDTH> addr = S_AXI_ARADDR.read();
-        sc_uint<C_S_AXI_DATA_WIDTH> rdata;
-
-        if (addr == 0x0) {
-            // Read from data register (returns gpio_in on read)
-            sc_uint<GPIO_WIDTH> gpio_in_val = gpio_in.read();
-            rdata = gpio_in_val;
-        } else if (addr == 0x4) {
-            // Read from direction register
-            sc_uint<GPIO_WIDTH> dir = reg_dir.read();
-            rdata = dir;
-        } else {
-            rdata = 0;
-        }
+        sc_uint<C_S_AXI_DATA_WIDTH> rdata = read_reg(addr);
 
         S_AXI_RDATA.write(rdata);
         S_AXI_RVALID.write(true);
@@ -133,3 +108,121 @@ void gpio_axi_lite::output_process() {
     gpio_out.write(data);
     gpio_oe.write(dir);
 }
+
+void gpio_axi_lite::mirror_process() {
+    // Keep the DMI image equal to what read_reg() returns
+    for (int i = 0; i < NUM_REGS; i++) {
+        dmi_regs[i] = (uint32_t)read_reg(i * 4).to_uint();
+    }
+}
+
+void gpio_axi_lite::update_process() {
+    // Drive the register signals (and through them the pins)
+    reg_data.write(data_val);
+    reg_dir.write(dir_val);
+}
+
+// The DMI image follows at once, the signals in the next delta
+void gpio_axi_lite::regs_changed() {
+    mirror_process();
+    reg_update.notify(SC_ZERO_TIME);
+}
+
+// Write with WSTRB semantics: only byte lanes with their strobe set change
+void gpio_axi_lite::write_reg(unsigned addr, sc_uint<C_S_AXI_DATA_WIDTH> data, sc_uint<C_S_AXI_DATA_WIDTH/8> strb) {
+    sc_uint<GPIO_WIDTH>* reg;
+    if (addr == 0x0) {
+        reg = &data_val;  // data register (gpio_out)
+    } else if (addr == 0x4) {
+        reg = &dir_val;   // direction register
+    } else {
+        return;
+    }
+
+    sc_uint<GPIO_WIDTH> current = *reg;
+    for (int i = 0; i < C_S_AXI_DATA_WIDTH / 8; i++) {
+        if (strb[i]) {
+            // Replace 8 bits at position i*8
+            for (int j = 0; j < 8; j++) {
+                if (i * 8 + j < GPIO_WIDTH) {
+                    current[i * 8 + j] = data[i * 8 + j];
+                }
+            }
+        }
+    }
+    *reg = current;
+    regs_changed();
+}
+
+sc_uint<gpio_axi_lite::C_S_AXI_DATA_WIDTH> gpio_axi_lite::read_reg(unsigned addr) {
+    if (addr == 0x0) {
+        // Read from data register (returns gpio_in on read)
+        sc_uint<GPIO_WIDTH> gpio_in_val = gpio_in.read();
+        return gpio_in_val;
+    } else if (addr == 0x4) {
+        // Read from direction register
+        return dir_val;
+    }
+    return 0;
+}
+
+// One access of up to 4 bytes inside one register. The byte enable array
+// (repeated if shorter than the data) becomes WSTRB for writes; on reads,
+// disabled bytes are left as they are.
+void gpio_axi_lite::b_transport(tlm::tlm_generic_payload& gp, sc_time& delay) {
+    const sc_dt::uint64 addr = gp.get_address();
+    const unsigned len = gp.get_data_length();
+    const unsigned lane = (unsigned)(addr & 3);
+    unsigned char* d = gp.get_data_ptr();
+    const unsigned char* be = gp.get_byte_enable_ptr();
+    const unsigned be_len = gp.get_byte_enable_length();
+
+    if (addr >= (sc_dt::uint64)NUM_REGS * 4) {
+        gp.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+        return;
+    }
+    if (len == 0 || lane + len > 4 || gp.get_streaming_width() < len) {
+        gp.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+        return;
+    }
+    if (be && be_len == 0) {
+        gp.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        return;
+    }
+
+    const unsigned reg_addr = (unsigned)addr & ~3u;
+    if (gp.is_write()) {
+        sc_uint<C_S_AXI_DATA_WIDTH> data = 0;
+        sc_uint<C_S_AXI_DATA_WIDTH/8> strb = 0;
+        for (unsigned k = 0; k < len; k++) {
+            if (be && be[k % be_len] != TLM_BYTE_ENABLED) continue;
+            data.range(8 * (lane + k) + 7, 8 * (lane + k)) = d[k];
+            strb[lane + k] = 1;
+        }
+        write_reg(reg_addr, data, strb);
+    } else if (gp.is_read()) {
+        const sc_uint<C_S_AXI_DATA_WIDTH> rdata = read_reg(reg_addr);
+        for (unsigned k = 0; k < len; k++) {
+            if (be && be[k % be_len] != TLM_BYTE_ENABLED) continue;
+            d[k] = (unsigned char)rdata.range(8 * (lane + k) + 7, 8 * (lane + k)).to_uint();
+        }
+    }
+
+    delay += tlm_latency;
+    gp.set_dmi_allowed(gp.is_read());
+    gp.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+bool gpio_axi_lite::get_direct_mem_ptr(tlm::tlm_generic_payload& gp, tlm::tlm_dmi& dmi) {
+    dmi.set_dmi_ptr(reinterpret_cast<unsigned char*>(dmi_regs));
+    dmi.set_start_address(0);
+    dmi.set_end_address(sizeof(dmi_regs) - 1);
+    dmi.set_read_latency(tlm_latency);
+    dmi.set_write_latency(tlm_latency);
+    if (gp.is_read()) {
+        dmi.allow_read();
+        return true;
+    }
+    dmi.allow_none(); // writes have side effects
+    return false;
+}
@@ -2,6 +2,9 @@
 #define GPIO_AXI_LITE_H
 
 #include <systemc.h>
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <stdint.h>
 
 SC_MODULE(gpio_axi_lite) {
 public:
@@ -46,7 +49,16 @@ public:
     sc_out<sc_uint<GPIO_WIDTH>>             gpio_out;
     sc_out<sc_uint<GPIO_WIDTH>>             gpio_oe;  // 1=drive output
 
-    // Internal register state
+    // TLM-2.0 target on the same registers (must be bound, like the ports).
+    // b_transport: accesses within one 32-bit register, byte enables act
+    // as WSTRB. DMI: read-only, over a mirror of what the registers read
+    // back (writes have side effects on the pins, so they always go
+    // through b_transport).
+    tlm_utils::simple_target_socket<gpio_axi_lite> tlm_skt;
+    sc_time                                  tlm_latency; // annotated per access
+
+    // Register state as seen on the pins, driven from the register values
+    // below one delta after each write
     sc_signal<sc_uint<GPIO_WIDTH>>          reg_data;  // Output values
     sc_signal<sc_uint<GPIO_WIDTH>>          reg_dir;   // Direction bits
 
@@ -54,9 +66,31 @@ public:
     void write_process();
     void read_process();
     void output_process();
+    void mirror_process();
+    void update_process();
+
+    // TLM interface
+    void b_transport(tlm::tlm_generic_payload& gp, sc_time& delay);
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload& gp, tlm::tlm_dmi& dmi);
+
+    // Register access shared by the AXI and TLM paths
+    void write_reg(unsigned addr, sc_uint<C_S_AXI_DATA_WIDTH> data, sc_uint<C_S_AXI_DATA_WIDTH/8> strb);
+    sc_uint<C_S_AXI_DATA_WIDTH> read_reg(unsigned addr);
 
     SC_CTOR(gpio_axi_lite);
     ~gpio_axi_lite();
+
+private:
+    static const int NUM_REGS = 1 << (C_S_AXI_ADDR_WIDTH - 2);
+
+    // Register values, updated immediately by the AXI and TLM paths so a
+    // TLM read right after a TLM write sees the new value
+    sc_uint<GPIO_WIDTH> data_val;
+    sc_uint<GPIO_WIDTH> dir_val;
+    sc_event            reg_update;     // data_val/dir_val changed
+    uint32_t dmi_regs[NUM_REGS]; // read_reg() image for DMI readers
+
+    void regs_changed();
 };
 
 #endif // GPIO_AXI_LITE_H
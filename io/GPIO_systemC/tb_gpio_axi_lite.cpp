@@ -1,4 +1,6 @@
 #include <systemc.h>
+#include <tlm.h>
+#include <tlm_utils/simple_initiator_socket.h>
 #include "gpio_axi_lite.h"
 
 SC_MODULE(tb_gpio) {
@@ -32,9 +34,37 @@ SC_MODULE(tb_gpio) {
     sc_signal<sc_uint<8>>           gpio_out;
     sc_signal<sc_uint<8>>           gpio_oe;
 
+    // TLM path to the same registers
+    tlm_utils::simple_initiator_socket<tb_gpio> tlm_skt;
+
     // DUT instance
     gpio_axi_lite *dut;
 
+    // One TLM access without waiting; returns the annotated delay.
+    // be = 0 for no byte enables
+    sc_time tlm_transport(bool write, unsigned addr, unsigned char* d, unsigned len, unsigned char* be = 0) {
+        tlm::tlm_generic_payload gp;
+        sc_time delay = SC_ZERO_TIME;
+        gp.set_command(write ? tlm::TLM_WRITE_COMMAND : tlm::TLM_READ_COMMAND);
+        gp.set_address(addr);
+        gp.set_data_ptr(d);
+        gp.set_data_length(len);
+        gp.set_streaming_width(len);
+        gp.set_byte_enable_ptr(be);
+        gp.set_byte_enable_length(be ? len : 0);
+        gp.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        tlm_skt->b_transport(gp, delay);
+        if (gp.is_response_error()) {
+            cout << "@" << sc_time_stamp() << ": TLM access failed: " << gp.get_response_string() << endl;
+        }
+        return delay;
+    }
+
+    // One TLM access, then wait out its delay
+    void tlm_access(bool write, unsigned addr, unsigned char* d, unsigned len, unsigned char* be = 0) {
+        wait(tlm_transport(write, addr, d, len, be));
+    }
+
     void testbench_process() {
         // Initialize signals
         reset_n.write(0);
@@ -110,13 +140,69 @@ SC_MODULE(tb_gpio) {
 
         cout << "@" << sc_time_stamp() << ": GPIO input read as 0x" << hex << rdata.read() << dec << endl;
 
+        // Test 6: TLM write to data register, byte enables as WSTRB
+        cout << "@" << sc_time_stamp() << ": Test 6 - TLM write data register (0x3C, lane 0 enabled)" << endl;
+        unsigned char wbuf[4] = {0x3C, 0x12, 0x34, 0x56};
+        unsigned char be_lane0[4] = {TLM_BYTE_ENABLED, TLM_BYTE_DISABLED, TLM_BYTE_DISABLED, TLM_BYTE_DISABLED};
+        tlm_access(true, 0x0, wbuf, 4, be_lane0);
+        wait(1, SC_NS);
+        cout << "@" << sc_time_stamp() << ": gpio_out = 0x" << hex << gpio_out.read() << dec
+             << (gpio_out.read() == 0x3C ? "" : " (expected 0x3c)") << endl;
+
+        // Test 7: lane 0 disabled, the register keeps its value
+        cout << "@" << sc_time_stamp() << ": Test 7 - TLM write with lane 0 disabled" << endl;
+        unsigned char be_none0[4] = {TLM_BYTE_DISABLED, TLM_BYTE_ENABLED, TLM_BYTE_ENABLED, TLM_BYTE_ENABLED};
+        wbuf[0] = 0x00;
+        tlm_access(true, 0x0, wbuf, 4, be_none0);
+        wait(1, SC_NS);
+        cout << "@" << sc_time_stamp() << ": gpio_out = 0x" << hex << gpio_out.read() << dec
+             << (gpio_out.read() == 0x3C ? "" : " (expected 0x3c)") << endl;
+
+        // Test 8: TLM read of the direction register written over AXI
+        unsigned rbuf = 0;
+        tlm_access(false, 0x4, (unsigned char*)&rbuf, 4);
+        cout << "@" << sc_time_stamp() << ": Test 8 - TLM read direction = 0x" << hex << rbuf << dec
+             << (rbuf == 0xFF ? "" : " (expected 0xff)") << endl;
+
+        // Test 9: DMI read of the input register follows gpio_in
+        cout << "@" << sc_time_stamp() << ": Test 9 - DMI read of GPIO input" << endl;
+        tlm::tlm_generic_payload dmi_gp;
+        tlm::tlm_dmi dmi;
+        dmi_gp.set_command(tlm::TLM_READ_COMMAND);
+        dmi_gp.set_address(0x0);
+        if (tlm_skt->get_direct_mem_ptr(dmi_gp, dmi) && dmi.is_read_allowed()) {
+            const unsigned char* regs = dmi.get_dmi_ptr();
+            gpio_in.write(0xC3);
+            wait(1, SC_NS);
+            cout << "@" << sc_time_stamp() << ": GPIO input via DMI = 0x" << hex << (unsigned)regs[0] << dec
+                 << (regs[0] == 0xC3 ? "" : " (expected 0xc3)") << endl;
+        } else {
+            cout << "@" << sc_time_stamp() << ": DMI not granted" << endl;
+        }
+
+        // Test 10: TLM write then read with no wait in between, over
+        // b_transport and DMI
+        cout << "@" << sc_time_stamp() << ": Test 10 - TLM write direction (0x0F), read back without waiting" << endl;
+        unsigned char dbuf[4] = {0x0F, 0x00, 0x00, 0x00};
+        tlm_transport(true, 0x4, dbuf, 4);
+        rbuf = 0;
+        tlm_transport(false, 0x4, (unsigned char*)&rbuf, 4);
+        cout << "@" << sc_time_stamp() << ": TLM read direction = 0x" << hex << rbuf << dec
+             << (rbuf == 0x0F ? "" : " (expected 0xf)") << endl;
+        dmi_gp.set_address(0x4);
+        if (tlm_skt->get_direct_mem_ptr(dmi_gp, dmi) && dmi.is_read_allowed()) {
+            const unsigned char* regs = dmi.get_dmi_ptr();
+            cout << "@" << sc_time_stamp() << ": Direction via DMI = 0x" << hex << (unsigned)regs[4] << dec
+                 << (regs[4] == 0x0F ? "" : " (expected 0xf)") << endl;
+        }
+
         // Test complete
         wait(50, SC_NS);
         cout << "@" << sc_time_stamp() << ": GPIO testbench complete" << endl;
         sc_stop();
     }
 
-    SC_CTOR(tb_gpio) : clk("clk", 20, SC_NS) {
+    SC_CTOR(tb_gpio) : clk("clk", 20, SC_NS), tlm_skt("tlm_skt") {
         dut = new gpio_axi_lite("gpio_dut");
 
         // Connect DUT ports
@@ -142,6 +228,7 @@ SC_MODULE(tb_gpio) {
         dut->gpio_in(gpio_in);
         dut->gpio_out(gpio_out);
         dut->gpio_oe(gpio_oe);
+        tlm_skt.bind(dut->tlm_skt);
 
         SC_THREAD(testbench_process);
         sensitive << clk.posedge_event();
@@ -0,0 +1,201 @@
+#ifndef UART_ARRAY_H
+#define UART_ARRAY_H
+
+#include <systemc.h>
+#include <stdint.h>
+
+// N UART channels (TX + RX each) advanced by one clocked SC_METHOD instead
+// of two SC_THREADs per channel. Per-channel ports and cycle behaviour are
+// those of Uart_core (Uart_tx + Uart_rx): same edges, same outputs. The
+// shared parameters are set with set_params/set_sampling before simulation.
+//
+// State is kept as structure-of-arrays, one array per field, so each clock
+// edge is: read the inputs that matter into arrays, one straight loop over
+// all channels that updates every state machine with selects instead of
+// branches, then write only the outputs that changed.
+template <int N>
+struct Uart_array : sc_module {
+    int DATA_WIDTH;
+    int BAUD_RATE;
+    int CLOCK_FREQ;
+    int STOP_BITS;
+    int SYNC_STAGES;
+    int OVERSAMPLE;
+    bool MAJORITY;
+    int CYCLES_PER_BIT;
+
+    sc_in<bool> clk;
+    sc_in<bool> rst_n;
+
+    // RX interface, per channel
+    sc_vector< sc_in<bool> >          rx;
+    sc_vector< sc_out< sc_uint<8> > > rx_data;
+    sc_vector< sc_out<bool> >         rx_valid;
+    sc_vector< sc_in<bool> >          rx_ready;
+    sc_vector< sc_out<bool> >         rx_framing_err;
+    sc_vector< sc_out<bool> >         rx_overrun_err;
+
+    // TX interface, per channel
+    sc_vector< sc_out<bool> >         tx;
+    sc_vector< sc_in< sc_uint<8> > >  tx_data;
+    sc_vector< sc_in<bool> >          tx_valid;
+    sc_vector< sc_out<bool> >         tx_ready;
+
+    SC_HAS_PROCESS(Uart_array);
+    explicit Uart_array(sc_module_name nm)
+    : sc_module(nm), DATA_WIDTH(8), BAUD_RATE(115200), CLOCK_FREQ(50000000), STOP_BITS(1),
+      SYNC_STAGES(2), OVERSAMPLE(16), MAJORITY(true),
+      rx("rx", N), rx_data("rx_data", N), rx_valid("rx_valid", N), rx_ready("rx_ready", N),
+      rx_framing_err("rx_framing_err", N), rx_overrun_err("rx_overrun_err", N),
+      tx("tx", N), tx_data("tx_data", N), tx_valid("tx_valid", N), tx_ready("tx_ready", N),
+      primed(false) {
+        set_params(DATA_WIDTH, BAUD_RATE, CLOCK_FREQ, STOP_BITS);
+        reset_state();
+        SC_METHOD(clock_edge);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    void set_params(int data_width, int baud_rate, int clock_freq, int stop_bits=1) {
+        DATA_WIDTH = data_width; BAUD_RATE = baud_rate; CLOCK_FREQ = clock_freq; STOP_BITS = stop_bits;
+        CYCLES_PER_BIT = (CLOCK_FREQ + BAUD_RATE/2) / BAUD_RATE;
+    }
+
+    // See Uart_rx::set_sampling
+    void set_sampling(int sync_stages, int oversample=16, bool majority=true) {
+        SYNC_STAGES = sync_stages < 0 ? 0 : (sync_stages > 32 ? 32 : sync_stages);
+        OVERSAMPLE = oversample; MAJORITY = majority;
+    }
+
+private:
+    // TX state
+    int32_t tx_cc[N], tx_bc[N];
+    uint8_t tx_sr[N], tx_idle[N], tx_line[N];
+    // RX state
+    uint32_t rx_sync[N];
+    int32_t rx_cc[N], rx_bc[N], rx_vote[N], rx_ones[N];
+    uint8_t rx_sr[N], rx_samp[N], rx_valid_q[N], rx_ferr_q[N], rx_oerr_q[N];
+    // Inputs of this edge and outputs to write
+    uint8_t in_rx[N], in_go[N], in_data[N], in_clr[N], got[N], bad[N];
+    uint8_t out_tx[N], out_ready[N];
+    bool    primed;
+
+    void reset_state() {
+        for (int i = 0; i < N; ++i) {
+            tx_cc[i] = 0; tx_bc[i] = 0; tx_sr[i] = 0; tx_idle[i] = 1; tx_line[i] = 1;
+            rx_sync[i] = ~0u; rx_cc[i] = 0; rx_bc[i] = 0; rx_vote[i] = 0; rx_ones[i] = 0;
+            rx_sr[i] = 0; rx_samp[i] = 0;
+        }
+    }
+
+    void write_outputs() {
+        for (int i = 0; i < N; ++i) {
+            const uint8_t rdy = tx_idle[i];
+            if (tx_line[i] != out_tx[i])  { tx[i].write(tx_line[i] != 0); out_tx[i] = tx_line[i]; }
+            if (rdy != out_ready[i])      { tx_ready[i].write(rdy != 0);   out_ready[i] = rdy; }
+        }
+    }
+
+    void clock_edge() {
+        // First edge: the threads' power-up writes, no state update (as Uart_tx/Uart_rx)
+        if (!primed) {
+            primed = true;
+            for (int i = 0; i < N; ++i) {
+                tx[i].write(true);        out_tx[i] = 1;
+                tx_ready[i].write(true);  out_ready[i] = 1;
+                rx_valid[i].write(false); rx_valid_q[i] = 0;
+                rx_data[i].write(0);
+                rx_framing_err[i].write(false); rx_ferr_q[i] = 0;
+                rx_overrun_err[i].write(false); rx_oerr_q[i] = 0;
+            }
+            return;
+        }
+
+        if (!rst_n.read()) {
+            reset_state();
+            write_outputs();
+            for (int i = 0; i < N; ++i) {
+                if (rx_valid_q[i]) { rx_valid[i].write(false); rx_valid_q[i] = 0; }
+                if (rx_ferr_q[i])  { rx_framing_err[i].write(false); rx_ferr_q[i] = 0; }
+                if (rx_oerr_q[i])  { rx_overrun_err[i].write(false); rx_oerr_q[i] = 0; }
+            }
+            return;
+        }
+
+        // Gather: only the inputs this edge can use
+        for (int i = 0; i < N; ++i) {
+            in_rx[i]  = rx[i].read();
+            in_clr[i] = rx_valid_q[i] && rx_ready[i].read();
+            in_go[i]  = tx_idle[i] && tx_valid[i].read();
+            in_data[i] = in_go[i] ? (uint8_t)tx_data[i].read().to_uint() : 0;
+        }
+
+        const int32_t cpb  = CYCLES_PER_BIT;
+        const int32_t dw   = DATA_WIDTH;
+        const int32_t last = DATA_WIDTH + STOP_BITS;
+        // RX sample points, as Uart_rx::offset
+        const int32_t os    = OVERSAMPLE > 0 ? OVERSAMPLE : 1;
+        const int32_t step  = MAJORITY ? (cpb / os > 0 ? cpb / os : 1) : 0;
+        const int32_t lead  = cpb / 2 - step > 0 ? cpb / 2 - step : 1;
+        const int32_t votes = MAJORITY ? 3 : 1;
+        const int32_t ss    = SYNC_STAGES;
+
+        // Update: every channel, no data-dependent branches
+        for (int i = 0; i < N; ++i) {
+            // TX (Uart_tx::tx_thread)
+            const int32_t cc    = tx_cc[i];
+            const int32_t bc    = tx_bc[i];
+            const uint8_t idle  = tx_idle[i];
+            const uint8_t go    = in_go[i];
+            const uint8_t tick  = !idle & (cc + 1 >= cpb);
+            const uint8_t data  = tick & (bc < dw);
+            const uint8_t stop  = tick & (bc >= dw) & (bc < last);
+            const uint8_t done  = tick & (bc >= last);
+            tx_line[i] = go ? 0 : data ? (tx_sr[i] & 1) : (stop | done) ? 1 : tx_line[i];
+            tx_sr[i]   = go ? in_data[i] : data ? (uint8_t)(tx_sr[i] >> 1) : tx_sr[i];
+            tx_bc[i]   = (go | done) ? 0 : (data | stop) ? bc + 1 : bc;
+            tx_cc[i]   = go ? 1 : idle ? cc : tick ? 0 : cc + 1;
+            tx_idle[i] = go ? 0 : done ? 1 : idle;
+
+            // RX (Uart_rx::rx_clocked_loop)
+            const uint32_t sy    = rx_sync[i];
+            const uint8_t b      = ss ? (uint8_t)((sy >> (ss - 1)) & 1u) : in_rx[i];
+            rx_sync[i] = (sy << 1) | in_rx[i];
+            const uint8_t samp   = rx_samp[i];
+            const int32_t rcc    = rx_cc[i] + 1;
+            const int32_t rbc    = rx_bc[i];
+            const int32_t vote   = rx_vote[i];
+            const uint8_t detect = !samp & !b;
+            const uint8_t at     = samp & (rcc == rbc * cpb + lead + vote * step);
+            const int32_t ones   = rx_ones[i] + (at & b);
+            const uint8_t decide = at & (vote + 1 == votes);
+            const uint8_t v      = 2 * ones > votes;
+            const uint8_t st_ok  = decide & (rbc == 0) & !v;
+            const uint8_t st_bad = decide & (rbc == 0) & v;
+            const uint8_t bit    = decide & (rbc >= 1) & (rbc <= dw);
+            const uint8_t stopb  = decide & (rbc > dw);
+            rx_sr[i]   = bit ? (uint8_t)((rx_sr[i] >> 1) | (v << (dw - 1))) : rx_sr[i];
+            rx_samp[i] = detect ? 1 : (st_bad | stopb) ? 0 : samp;
+            rx_cc[i]   = detect ? 0 : samp ? rcc : rx_cc[i];
+            rx_bc[i]   = detect ? 0 : (st_ok | bit) ? rbc + 1 : rbc;
+            rx_vote[i] = (detect | decide) ? 0 : at ? vote + 1 : vote;
+            rx_ones[i] = (detect | decide) ? 0 : ones;
+            got[i]     = stopb & v;
+            bad[i]     = stopb & !v;
+        }
+
+        // Scatter: changed outputs only
+        write_outputs();
+        for (int i = 0; i < N; ++i) {
+            if (got[i]) rx_data[i].write(rx_sr[i]);
+            const uint8_t ferr = bad[i] ? 1 : got[i] ? 0 : rx_ferr_q[i];
+            const uint8_t oerr = got[i] ? (rx_valid_q[i] & !in_clr[i]) : bad[i] ? 0 : rx_oerr_q[i];
+            const uint8_t v = got[i] | (rx_valid_q[i] & !in_clr[i]);
+            if (ferr != rx_ferr_q[i]) { rx_framing_err[i].write(ferr != 0); rx_ferr_q[i] = ferr; }
+            if (oerr != rx_oerr_q[i]) { rx_overrun_err[i].write(oerr != 0); rx_oerr_q[i] = oerr; }
+            if (v != rx_valid_q[i])   { rx_valid[i].write(v != 0); rx_valid_q[i] = v; }
+        }
+    }
+};
+
+#endif // UART_ARRAY_H
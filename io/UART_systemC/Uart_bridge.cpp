@@ -0,0 +1,50 @@
+#include "Uart_bridge.h"
+
+void Uart_bridge::tx_transport(tlm::tlm_generic_payload& gp, sc_time& delay) {
+    if (!gp.is_write() || gp.get_byte_enable_ptr()) {
+        gp.set_response_status(tlm::TLM_COMMAND_ERROR_RESPONSE);
+        return;
+    }
+    const unsigned char* d = gp.get_data_ptr();
+    const unsigned n = gp.get_data_length();
+
+    // Pins are cycle accurate: catch up with the caller's local time first
+    wait(delay);
+    delay = SC_ZERO_TIME;
+
+    wait(clk.posedge_event());
+    for (unsigned i = 0; i < n; ++i) {
+        while (!tx_ready.read()) {
+            wait(tx_ready.posedge_event());
+            wait(clk.posedge_event());
+        }
+        tx_data.write(d[i]);
+        tx_valid.write(true);
+        wait(clk.posedge_event()); // core latches the byte on this edge
+        tx_valid.write(false);
+        wait(clk.posedge_event()); // tx_ready reads low from here until the frame is out
+    }
+    if (n && !tx_ready.read()) wait(tx_ready.posedge_event());
+
+    gp.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void Uart_bridge::rx_thread() {
+    rx_ready.write(true);
+
+    unsigned char b;
+    rx_gp.set_command(tlm::TLM_WRITE_COMMAND);
+    rx_gp.set_address(0);
+    rx_gp.set_data_ptr(&b);
+    rx_gp.set_data_length(1);
+    rx_gp.set_streaming_width(1);
+    rx_gp.set_byte_enable_ptr(0);
+
+    while (true) {
+        wait(rx_valid.posedge_event());
+        b = (unsigned char)rx_data.read().to_uint();
+        rx_gp.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        sc_time t = SC_ZERO_TIME;
+        rx_skt->b_transport(rx_gp, t);
+    }
+}
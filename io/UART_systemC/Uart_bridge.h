@@ -0,0 +1,48 @@
+#ifndef UART_BRIDGE_H
+#define UART_BRIDGE_H
+
+#include <systemc.h>
+#include <tlm.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/simple_target_socket.h>
+
+// Puts Uart_core's byte handshake pins behind the same host-side sockets as
+// Uart_tlm, so a test or SoC can run against the cycle-accurate core and
+// then swap in the TLM model unchanged.
+//
+//   tx_skt (target)    write of N bytes: each one is handed to the core over
+//                      tx_data/tx_valid when tx_ready allows; returns once
+//                      the core raises tx_ready after the last frame.
+//                      The pins have one writer, so call it from one process.
+//   rx_skt (initiator) one single-byte write per rx_valid from the core;
+//                      rx_ready is held high, so every byte is taken at once
+SC_MODULE(Uart_bridge) {
+    sc_in<bool> clk;
+    sc_in<bool> rst_n;
+
+    // to Uart_core TX
+    sc_out< sc_uint<8> > tx_data;
+    sc_out<bool>         tx_valid;
+    sc_in<bool>          tx_ready;
+
+    // from Uart_core RX
+    sc_in< sc_uint<8> >  rx_data;
+    sc_in<bool>          rx_valid;
+    sc_out<bool>         rx_ready;
+
+    tlm_utils::simple_target_socket<Uart_bridge>    tx_skt;
+    tlm_utils::simple_initiator_socket<Uart_bridge> rx_skt;
+
+    void tx_transport(tlm::tlm_generic_payload& gp, sc_time& delay);
+    void rx_thread();
+
+    SC_CTOR(Uart_bridge) : tx_skt("tx_skt"), rx_skt("rx_skt") {
+        tx_skt.register_b_transport(this, &Uart_bridge::tx_transport);
+        SC_THREAD(rx_thread);
+    }
+
+private:
+    tlm::tlm_generic_payload rx_gp;
+};
+
+#endif // UART_BRIDGE_H
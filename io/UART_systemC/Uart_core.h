@@ -2,13 +2,25 @@
 #define UART_CORE_H
 
 #include <systemc.h>
+#include <deque>
 #include "Uart_tx.h"
 #include "Uart_rx.h"
 
+// Uart_tx + Uart_rx behind one byte handshake per direction.
+//
+// Built with FIFO depths (second constructor), a TX FIFO sits between the
+// tx_* pins and Uart_tx and an RX FIFO between Uart_rx and the rx_* pins:
+// tx_ready means "TX FIFO not full", rx_valid/rx_data show the RX FIFO
+// head. Both FIFOs advance on clk edges. Uart_rx only reports an overrun
+// once the RX FIFO is full. The burst API (tx_write/rx_read) reaches the
+// same FIFOs directly, e.g. from a register front-end (Uart_regs); use
+// either it or the pins for a given direction, not both.
 SC_MODULE(Uart_core) {
     int DATA_WIDTH;
     int BAUD_RATE;
     int CLOCK_FREQ;
+    int TX_FIFO_DEPTH; // 0: tx_* pins wired straight to Uart_tx
+    int RX_FIFO_DEPTH; // 0: rx_* pins wired straight to Uart_rx
 
     sc_in<bool> clk;
     sc_in<bool> rst_n;
@@ -18,6 +30,8 @@ SC_MODULE(Uart_core) {
     sc_out< sc_uint<8> > rx_data;
     sc_out<bool> rx_valid;
     sc_in<bool> rx_ready;
+    sc_out<bool> rx_framing_err;
+    sc_out<bool> rx_overrun_err;
 
     // TX interface
     sc_out<bool> tx;
@@ -29,7 +43,61 @@ SC_MODULE(Uart_core) {
     Uart_tx *tx_inst;
     Uart_rx *rx_inst;
 
-    SC_CTOR(Uart_core) : DATA_WIDTH(8), BAUD_RATE(115200), CLOCK_FREQ(50000000) {
+    // FIFO mode: handshakes between the FIFOs and tx_inst/rx_inst
+    sc_signal< sc_uint<8> > txq_data, rxq_data;
+    sc_signal<bool> txq_valid, txq_ready, rxq_valid, rxq_ready;
+    sc_event fifo_ev; // a FIFO level changed
+
+    SC_CTOR(Uart_core) : DATA_WIDTH(8), BAUD_RATE(115200), CLOCK_FREQ(50000000),
+                         TX_FIFO_DEPTH(0), RX_FIFO_DEPTH(0) {
+        build();
+    }
+
+    Uart_core(sc_module_name, int tx_fifo_depth, int rx_fifo_depth)
+    : DATA_WIDTH(8), BAUD_RATE(115200), CLOCK_FREQ(50000000),
+      TX_FIFO_DEPTH(tx_fifo_depth > 0 ? tx_fifo_depth : 0),
+      RX_FIFO_DEPTH(rx_fifo_depth > 0 ? rx_fifo_depth : 0) {
+        build();
+    }
+
+    // RX synchronizer and sampling (see Uart_rx::set_sampling)
+    void set_rx_sampling(int sync_stages, int oversample=16, bool majority=true) {
+        rx_inst->set_sampling(sync_stages, oversample, majority);
+    }
+
+    // Event-driven TX/RX (see Uart_tx/Uart_rx::set_event_driven)
+    void set_event_driven(bool on) {
+        tx_inst->set_event_driven(on);
+        rx_inst->set_event_driven(on);
+    }
+
+    // Burst API, FIFO mode only. Moves up to n bytes in one call and returns
+    // how many fit (tx_write) or were there (rx_read); the serial side and
+    // the pins follow from the next clk edge.
+    int tx_write(const unsigned char* d, int n) {
+        int k = 0;
+        while (k < n && (int)tx_fifo.size() < TX_FIFO_DEPTH) tx_fifo.push_back(d[k++]);
+        if (k) fifo_ev.notify(SC_ZERO_TIME);
+        return k;
+    }
+    int rx_read(unsigned char* d, int n) {
+        int k = 0;
+        while (k < n && !rx_fifo.empty()) { d[k++] = rx_fifo.front(); rx_fifo.pop_front(); }
+        if (k) fifo_ev.notify(SC_ZERO_TIME);
+        return k;
+    }
+    int tx_fifo_level() const { return (int)tx_fifo.size(); }
+    int rx_fifo_level() const { return (int)rx_fifo.size(); }
+
+    ~Uart_core() {
+        if (tx_inst) delete tx_inst;
+        if (rx_inst) delete rx_inst;
+    }
+
+private:
+    std::deque<unsigned char> tx_fifo, rx_fifo;
+
+    void build() {
         tx_inst = new Uart_tx("uart_tx");
         rx_inst = new Uart_rx("uart_rx");
 
@@ -37,23 +105,74 @@ SC_MODULE(Uart_core) {
         tx_inst->clk(clk);
         tx_inst->rst_n(rst_n);
         tx_inst->tx(tx);
-        tx_inst->data_in(tx_data);
-        tx_inst->valid(tx_valid);
-        tx_inst->ready(tx_ready);
+        if (TX_FIFO_DEPTH) {
+            tx_inst->data_in(txq_data);
+            tx_inst->valid(txq_valid);
+            tx_inst->ready(txq_ready);
+        } else {
+            tx_inst->data_in(tx_data);
+            tx_inst->valid(tx_valid);
+            tx_inst->ready(tx_ready);
+        }
         tx_inst->set_params(DATA_WIDTH, BAUD_RATE, CLOCK_FREQ);
 
         rx_inst->clk(clk);
         rx_inst->rst_n(rst_n);
         rx_inst->rx(rx);
-        rx_inst->data_out(rx_data);
-        rx_inst->valid(rx_valid);
-        rx_inst->ready(rx_ready);
+        if (RX_FIFO_DEPTH) {
+            rx_inst->data_out(rxq_data);
+            rx_inst->valid(rxq_valid);
+            rx_inst->ready(rxq_ready);
+        } else {
+            rx_inst->data_out(rx_data);
+            rx_inst->valid(rx_valid);
+            rx_inst->ready(rx_ready);
+        }
+        rx_inst->framing_err(rx_framing_err);
+        rx_inst->overrun_err(rx_overrun_err);
         rx_inst->set_params(DATA_WIDTH, BAUD_RATE, CLOCK_FREQ);
+
+        if (TX_FIFO_DEPTH || RX_FIFO_DEPTH) {
+            SC_METHOD(fifo_edge);
+            sensitive << clk.pos();
+            dont_initialize();
+        }
     }
 
-    ~Uart_core() {
-        if (tx_inst) delete tx_inst;
-        if (rx_inst) delete rx_inst;
+    // One clk edge of both FIFOs. A handshake completes on an edge where
+    // valid and ready were both high before it, the same rule Uart_tx and
+    // Uart_rx apply on their side.
+    void fifo_edge() {
+        const size_t tx_n = tx_fifo.size(), rx_n = rx_fifo.size();
+
+        if (!rst_n.read()) {
+            tx_fifo.clear();
+            rx_fifo.clear();
+        } else {
+            if (TX_FIFO_DEPTH) {
+                if (txq_valid.read() && txq_ready.read() && !tx_fifo.empty()) tx_fifo.pop_front();
+                if (tx_valid.read() && tx_ready.read()) {
+                    if ((int)tx_fifo.size() < TX_FIFO_DEPTH) tx_fifo.push_back((unsigned char)tx_data.read().to_uint());
+                    else SC_REPORT_WARNING(name(), "TX FIFO filled by tx_write and the pins at once, byte dropped");
+                }
+            }
+            if (RX_FIFO_DEPTH) {
+                if (rx_valid.read() && rx_ready.read() && !rx_fifo.empty()) rx_fifo.pop_front();
+                if (rxq_valid.read() && rxq_ready.read()) rx_fifo.push_back((unsigned char)rxq_data.read().to_uint());
+            }
+        }
+
+        if (TX_FIFO_DEPTH) {
+            txq_valid.write(!tx_fifo.empty());
+            if (!tx_fifo.empty()) txq_data.write(tx_fifo.front());
+            tx_ready.write((int)tx_fifo.size() < TX_FIFO_DEPTH);
+        }
+        if (RX_FIFO_DEPTH) {
+            rxq_ready.write((int)rx_fifo.size() < RX_FIFO_DEPTH);
+            rx_valid.write(!rx_fifo.empty());
+            if (!rx_fifo.empty()) rx_data.write(rx_fifo.front());
+        }
+        if (tx_fifo.size() != tx_n || rx_fifo.size() != rx_n) fifo_ev.notify(SC_ZERO_TIME);
     }
 };
 
@@ -0,0 +1,259 @@
+#ifndef UART_FIXED_H
+#define UART_FIXED_H
+
+#include <systemc.h>
+
+// Compile-time configured UART: data width (5..9), stop bits (1..2) and
+// parity are template parameters, so the frame layout is constexpr and the
+// per-cycle code works on fixed-width words. Baud rate and clock stay
+// runtime (set_params). Behaviour with PARITY none matches Uart_tx/Uart_rx
+// in clocked mode edge for edge; those remain for runtime configuration.
+
+enum Uart_parity { UART_PARITY_NONE, UART_PARITY_EVEN, UART_PARITY_ODD };
+
+// Parity bit to send after the W data bits of v
+template <int W, Uart_parity PARITY>
+inline unsigned uart_parity_bit(unsigned v) {
+    unsigned p = 0;
+    for (int k = 0; k < W; ++k) p ^= (v >> k) & 1u;
+    return PARITY == UART_PARITY_ODD ? p ^ 1u : p;
+}
+
+template <int W, int STOP = 1, Uart_parity PARITY = UART_PARITY_NONE>
+struct Uart_tx_fixed : sc_module {
+    static_assert(W >= 5 && W <= 9, "Uart_tx_fixed: 5..9 data bits");
+    static_assert(STOP >= 1 && STOP <= 2, "Uart_tx_fixed: 1 or 2 stop bits");
+
+    static constexpr int      PARITY_BITS = PARITY == UART_PARITY_NONE ? 0 : 1;
+    static constexpr int      TAIL_BITS   = W + PARITY_BITS + STOP; // after the start bit
+    static constexpr unsigned DATA_MASK   = (1u << W) - 1;
+    static constexpr unsigned STOP_MASK   = ((1u << STOP) - 1) << (W + PARITY_BITS);
+
+    int BAUD_RATE;
+    int CLOCK_FREQ;
+    int CYCLES_PER_BIT;
+
+    sc_in<bool> clk;
+    sc_in<bool> rst_n;
+
+    sc_out<bool> tx; // serial line
+
+    sc_in< sc_uint<W> > data_in;
+    sc_in<bool>         valid;
+    sc_out<bool>        ready;
+
+    SC_HAS_PROCESS(Uart_tx_fixed);
+    explicit Uart_tx_fixed(sc_module_name nm)
+    : sc_module(nm), BAUD_RATE(9600), CLOCK_FREQ(50000000) {
+        set_params(BAUD_RATE, CLOCK_FREQ);
+        SC_THREAD(tx_thread);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    void set_params(int baud_rate, int clock_freq) {
+        BAUD_RATE = baud_rate; CLOCK_FREQ = clock_freq;
+        CYCLES_PER_BIT = (CLOCK_FREQ + BAUD_RATE/2) / BAUD_RATE;
+    }
+
+    void tx_thread() {
+        const int cpb = CYCLES_PER_BIT;
+        unsigned frame = 0;  // bits still to send after the start bit, LSB first
+        int left = 0;        // how many of them
+        int cycle_counter = 0;
+        bool idle = true;
+
+        tx.write(true);
+        ready.write(true);
+
+        while (true) {
+            wait(); // posedge clk
+
+            if (!rst_n.read()) {
+                tx.write(true);
+                ready.write(true);
+                idle = true;
+                cycle_counter = 0;
+                continue;
+            }
+
+            if (idle) {
+                ready.write(true);
+                if (valid.read()) {
+                    const unsigned d = data_in.read().to_uint() & DATA_MASK;
+                    frame = d | STOP_MASK;
+                    if (PARITY_BITS) frame |= uart_parity_bit<W, PARITY>(d) << W;
+                    left = TAIL_BITS;
+                    idle = false;
+                    ready.write(false);
+                    tx.write(false); // start bit
+                    cycle_counter = 1;
+                }
+                continue;
+            }
+
+            // one bit per CYCLES_PER_BIT, then one more tick back to idle
+            if (++cycle_counter < cpb) continue;
+            cycle_counter = 0;
+            if (left) {
+                tx.write(frame & 1u);
+                frame >>= 1;
+                --left;
+            } else {
+                idle = true;
+                ready.write(true);
+                tx.write(true);
+            }
+        }
+    }
+};
+
+template <int W, int STOP = 1, Uart_parity PARITY = UART_PARITY_NONE>
+struct Uart_rx_fixed : sc_module {
+    static_assert(W >= 5 && W <= 9, "Uart_rx_fixed: 5..9 data bits");
+    static_assert(STOP >= 1 && STOP <= 2, "Uart_rx_fixed: 1 or 2 stop bits");
+
+    static constexpr int PARITY_BITS = PARITY == UART_PARITY_NONE ? 0 : 1;
+    static constexpr int STOP_BIT    = 1 + W + PARITY_BITS; // index of the (first) stop bit
+
+    int BAUD_RATE;
+    int CLOCK_FREQ;
+    int CYCLES_PER_BIT;
+    int SYNC_STAGES;
+    int OVERSAMPLE;
+    bool MAJORITY;
+
+    sc_in<bool> clk;
+    sc_in<bool> rst_n;
+
+    sc_in<bool> rx; // serial input
+
+    sc_out< sc_uint<W> > data_out;
+    sc_out<bool>         valid;
+    sc_in<bool>          ready;
+
+    // As Uart_rx, plus parity_err: the byte was delivered but its parity
+    // bit did not match
+    sc_out<bool>         framing_err;
+    sc_out<bool>         overrun_err;
+    sc_out<bool>         parity_err;
+
+    SC_HAS_PROCESS(Uart_rx_fixed);
+    explicit Uart_rx_fixed(sc_module_name nm)
+    : sc_module(nm), BAUD_RATE(9600), CLOCK_FREQ(50000000),
+      SYNC_STAGES(2), OVERSAMPLE(16), MAJORITY(true) {
+        set_params(BAUD_RATE, CLOCK_FREQ);
+        SC_THREAD(rx_thread);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    void set_params(int baud_rate, int clock_freq) {
+        BAUD_RATE = baud_rate; CLOCK_FREQ = clock_freq;
+        CYCLES_PER_BIT = (CLOCK_FREQ + BAUD_RATE/2) / BAUD_RATE;
+    }
+
+    // See Uart_rx::set_sampling
+    void set_sampling(int sync_stages, int oversample=16, bool majority=true) {
+        SYNC_STAGES = sync_stages < 0 ? 0 : (sync_stages > 32 ? 32 : sync_stages);
+        OVERSAMPLE = oversample; MAJORITY = majority;
+    }
+
+    void rx_thread() {
+        // Sample points as Uart_rx::offset, walked incrementally
+        const int cpb   = CYCLES_PER_BIT;
+        const int os    = OVERSAMPLE > 0 ? OVERSAMPLE : 1;
+        const int step  = MAJORITY ? (cpb / os > 0 ? cpb / os : 1) : 0;
+        const int lead  = cpb / 2 - step > 0 ? cpb / 2 - step : 1;
+        const int votes = MAJORITY ? 3 : 1;
+        const int ss    = SYNC_STAGES;
+
+        unsigned sync_q = ~0u;
+        bool receiving = false;
+        int cycle_counter = 0;
+        int next_at = 0;
+        int bit_counter = 0;
+        int vote = 0;
+        int ones = 0;
+        unsigned shift_reg = 0;
+        unsigned parity = 0;
+        bool valid_q = false;
+
+        valid.write(false);
+        data_out.write(0);
+        framing_err.write(false);
+        overrun_err.write(false);
+        parity_err.write(false);
+
+        while (true) {
+            wait(); // posedge clk
+
+            if (!rst_n.read()) {
+                sync_q = ~0u;
+                receiving = false;
+                valid.write(false); valid_q = false;
+                framing_err.write(false);
+                overrun_err.write(false);
+                parity_err.write(false);
+                continue;
+            }
+
+            const unsigned in = rx.read() ? 1u : 0u;
+            const unsigned b  = ss ? (sync_q >> (ss - 1)) & 1u : in;
+            sync_q = (sync_q << 1) | in;
+
+            bool clear = valid_q && ready.read();
+
+            if (!receiving) {
+                if (!b) {
+                    receiving = true;
+                    cycle_counter = 0;
+                    next_at = lead;
+                    bit_counter = 0;
+                    vote = 0;
+                    ones = 0;
+                    parity = PARITY == UART_PARITY_ODD ? 1u : 0u;
+                }
+            } else if (++cycle_counter == next_at) {
+                ones += b;
+                if (++vote < votes) {
+                    next_at += step;
+                } else {
+                    const unsigned v = 2 * ones > votes;
+                    next_at += cpb - (votes - 1) * step;
+                    vote = 0;
+                    ones = 0;
+                    if (bit_counter == 0) {
+                        // start bit must still be low, else it was a glitch
+                        receiving = !v;
+                    } else if (bit_counter <= W) {
+                        // LSB first, from the top of a W-bit register
+                        shift_reg = (shift_reg >> 1) | (v << (W - 1));
+                        parity ^= v;
+                    } else if (PARITY_BITS && bit_counter < STOP_BIT) {
+                        parity ^= v;
+                    } else {
+                        receiving = false;
+                        if (v) {
+                            data_out.write(shift_reg);
+                            overrun_err.write(valid_q && !clear);
+                            parity_err.write(PARITY_BITS && parity);
+                            framing_err.write(false);
+                            valid.write(true); valid_q = true;
+                            clear = false;
+                        } else {
+                            framing_err.write(true);
+                            overrun_err.write(false);
+                            parity_err.write(false);
+                        }
+                    }
+                    ++bit_counter;
+                }
+            }
+
+            if (clear) { valid.write(false); valid_q = false; }
+        }
+    }
+};
+
+#endif // UART_FIXED_H
@@ -0,0 +1,100 @@
+#include "Uart_regs.h"
+#include <cstring>
+
+Uart_regs::Uart_regs(sc_module_name nm, int tx_fifo_depth, int rx_fifo_depth)
+: sc_module(nm), skt("skt"),
+  core("uart_core", tx_fifo_depth > 0 ? tx_fifo_depth : 1, rx_fifo_depth > 0 ? rx_fifo_depth : 1),
+  irq_en(0), tx_thresh(0), rx_thresh(1) {
+    core.clk(clk);
+    core.rst_n(rst_n);
+    core.rx(rx);
+    core.tx(tx);
+    core.rx_data(rx_data);
+    core.rx_valid(rx_valid);
+    core.rx_ready(rx_ready);
+    core.rx_framing_err(framing_err);
+    core.rx_overrun_err(overrun_err);
+    core.tx_data(tx_data);
+    core.tx_valid(tx_valid);
+    core.tx_ready(tx_ready);
+
+    skt.register_b_transport(this, &Uart_regs::transport);
+
+    SC_METHOD(update_irq);
+    sensitive << core.fifo_ev << framing_err << overrun_err << reg_ev;
+}
+
+unsigned Uart_regs::irq_stat() const {
+    unsigned s = 0;
+    if ((unsigned)core.tx_fifo_level() <= tx_thresh) s |= IRQ_TX_LOW;
+    if ((unsigned)core.rx_fifo_level() >= rx_thresh) s |= IRQ_RX_HIGH;
+    if (framing_err.read() || overrun_err.read())    s |= IRQ_RX_ERR;
+    return s;
+}
+
+unsigned Uart_regs::status() const {
+    const unsigned tx_n = core.tx_fifo_level(), rx_n = core.rx_fifo_level();
+    return (tx_n & 0xff) | (rx_n & 0xff) << 8
+         | (tx_n >= (unsigned)core.TX_FIFO_DEPTH ? 1u << 16 : 0)
+         | (rx_n == 0 ? 1u << 17 : 0)
+         | (framing_err.read() ? 1u << 18 : 0)
+         | (overrun_err.read() ? 1u << 19 : 0);
+}
+
+void Uart_regs::update_irq() {
+    irq.write((irq_stat() & irq_en) != 0);
+}
+
+void Uart_regs::transport(tlm::tlm_generic_payload& gp, sc_time& delay) {
+    unsigned char* d = gp.get_data_ptr();
+    const int n = (int)gp.get_data_length();
+    const sc_dt::uint64 addr = gp.get_address();
+
+    if (gp.get_byte_enable_ptr()) {
+        gp.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        return;
+    }
+
+    // FIFO state moves on clk edges: catch up with the caller first
+    wait(delay);
+    delay = SC_ZERO_TIME;
+
+    if (addr == REG_DATA) {
+        int done = 0;
+        while (done < n) {
+            if (gp.is_write()) done += core.tx_write(d + done, n - done);
+            else               done += core.rx_read(d + done, n - done);
+            if (done < n) wait(core.fifo_ev);
+        }
+        gp.set_response_status(tlm::TLM_OK_RESPONSE);
+        return;
+    }
+
+    if (n != 4 || (addr & 3) || addr > REG_DEPTH) {
+        gp.set_response_status(addr > REG_DEPTH ? tlm::TLM_ADDRESS_ERROR_RESPONSE
+                                                : tlm::TLM_BURST_ERROR_RESPONSE);
+        return;
+    }
+
+    unsigned v = 0;
+    if (gp.is_write()) {
+        memcpy(&v, d, 4);
+        switch (addr) {
+        case REG_IRQ_EN: irq_en = v & 7; break;
+        case REG_THRESH: tx_thresh = v & 0xff; rx_thresh = (v >> 8) & 0xff; break;
+        default: break; // read-only
+        }
+        reg_ev.notify(SC_ZERO_TIME);
+    } else {
+        switch (addr) {
+        case REG_STATUS:   v = status(); break;
+        case REG_IRQ_EN:   v = irq_en; break;
+        case REG_IRQ_STAT: v = irq_stat(); break;
+        case REG_THRESH:   v = tx_thresh | rx_thresh << 8; break;
+        case REG_DEPTH:    v = (core.TX_FIFO_DEPTH & 0xff) | (core.RX_FIFO_DEPTH & 0xff) << 8; break;
+        default: break;
+        }
+        memcpy(d, &v, 4);
+    }
+    gp.set_response_status(tlm::TLM_OK_RESPONSE);
+}
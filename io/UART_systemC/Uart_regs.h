@@ -0,0 +1,66 @@
+#ifndef UART_REGS_H
+#define UART_REGS_H
+
+#include <systemc.h>
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include "Uart_core.h"
+
+// Memory-mapped UART: a Uart_core with TX/RX FIFOs behind a TLM target
+// socket, plus one level interrupt. 32-bit registers:
+//
+//   0x00 DATA      W: every byte of the write goes into the TX FIFO, so a
+//                  whole buffer is one transaction; returns once the last
+//                  byte is queued.  R: n bytes popped from the RX FIFO;
+//                  returns once n bytes have arrived.
+//   0x04 STATUS    RO [7:0] TX level, [15:8] RX level, [16] TX full,
+//                  [17] RX empty, [18] framing error, [19] overrun error
+//   0x08 IRQ_EN    [0] TX low, [1] RX high, [2] RX error
+//   0x0C IRQ_STAT  RO, same bits, unmasked:
+//                  TX low    TX level <= THRESH.tx
+//                  RX high   RX level >= THRESH.rx
+//                  RX error  framing or overrun error
+//   0x10 THRESH    [7:0] tx (default 0), [15:8] rx (default 1)
+//   0x14 DEPTH     RO [7:0] TX FIFO depth, [15:8] RX FIFO depth
+//
+// irq = |(IRQ_STAT & IRQ_EN). Registers other than DATA take single 4-byte
+// accesses without byte enables.
+SC_MODULE(Uart_regs) {
+    enum {
+        REG_DATA = 0x00, REG_STATUS = 0x04, REG_IRQ_EN = 0x08,
+        REG_IRQ_STAT = 0x0C, REG_THRESH = 0x10, REG_DEPTH = 0x14
+    };
+    enum { IRQ_TX_LOW = 1, IRQ_RX_HIGH = 2, IRQ_RX_ERR = 4 };
+
+    sc_in<bool> clk;
+    sc_in<bool> rst_n;
+
+    sc_in<bool>  rx;
+    sc_out<bool> tx;
+    sc_out<bool> irq;
+
+    tlm_utils::simple_target_socket<Uart_regs> skt;
+
+    Uart_core core;
+
+    void transport(tlm::tlm_generic_payload& gp, sc_time& delay);
+    void update_irq();
+
+    SC_HAS_PROCESS(Uart_regs);
+    Uart_regs(sc_module_name nm, int tx_fifo_depth = 16, int rx_fifo_depth = 16);
+
+private:
+    // core pins the registers don't use (the burst API moves the data)
+    sc_signal< sc_uint<8> > tx_data, rx_data;
+    sc_signal<bool> tx_valid, tx_ready, rx_valid, rx_ready;
+    sc_signal<bool> framing_err, overrun_err;
+
+    unsigned irq_en;
+    unsigned tx_thresh, rx_thresh;
+    sc_event reg_ev;
+
+    unsigned irq_stat() const;
+    unsigned status() const;
+};
+
+#endif // UART_REGS_H
@@ -3,87 +3,225 @@
 void Uart_rx::rx_thread() {
     CYCLES_PER_BIT = (CLOCK_FREQ + BAUD_RATE/2) / BAUD_RATE;
 
-    bool sampling = false;
+    valid.write(false);
+    data_out.write(0);
+    framing_err.write(false);
+    overrun_err.write(false);
+
+    wait(); // posedge clk
+    if (EVENT_DRIVEN && SYNC_STAGES < lead()) {
+        rx_event_loop();
+    } else {
+        if (EVENT_DRIVEN)
+            SC_REPORT_WARNING(name(), "synchronizer deeper than the first sample point, running clocked");
+        rx_clocked_loop();
+    }
+}
+
+// rx through this instance's synchronizer: the value SYNC_STAGES edges ago
+bool Uart_rx::sync_rx() {
+    const bool in = rx.read();
+    if (SYNC_STAGES <= 0) return in;
+    const bool out = (sync_q >> (SYNC_STAGES - 1)) & 1u;
+    sync_q = (sync_q << 1) | (in ? 1u : 0u);
+    return out;
+}
+
+void Uart_rx::reset_rx() {
+    sync_q = ~0u; // line idles high
+    write_valid(false);
+    framing_err.write(false);
+    overrun_err.write(false);
+}
+
+void Uart_rx::rx_clocked_loop() {
+    bool receiving = false;
     int cycle_counter = 0;
     int bit_counter = 0;
+    int vote = 0;
+    int ones = 0;
     sc_uint<8> shift_reg = 0;
 
-    valid.write(false);
-    data_out.write(0);
-
     while (true) {
-        wait(); // posedge clk
-
         if (!rst_n.read()) {
-            sampling = false;
-            cycle_counter = 0;
-            bit_counter = 0;
+            receiving = false;
             shift_reg = 0;
-            valid.write(false);
+            reset_rx();
+            wait(); // posedge clk
             continue;
         }
 
-        // Simple input synchronization: shift two-stage
-        static bool rx_sync_0 = true;
-        static bool rx_sync_1 = true;
-        rx_sync_0 = rx.read();
-        rx_sync_1 = rx_sync_0;
+        const bool b = sync_rx();
+        bool ended = false;
+        bool stop_ok = false;
 
-        if (!sampling) {
+        if (!receiving) {
             // detect start bit (line goes low)
-            if (rx_sync_1 == false) {
-                sampling = true;
-                cycle_counter = 1;
+            if (!b) {
+                receiving = true;
+                cycle_counter = 0;
                 bit_counter = 0; // start bit
+                vote = 0;
+                ones = 0;
             }
         } else {
             cycle_counter += 1;
-            if (cycle_counter >= (CYCLES_PER_BIT/2)) {
-                // sample in middle of bit
-                if (bit_counter == 0) {
-                    // sample start bit; if not low, abort
-                    if (rx_sync_1 != false) {
-                        sampling = false; // false start
-                    } else {
-                        cycle_counter = 0;
-                        bit_counter = 1; // move to first data bit on next milestone
-                    }
-                } else if (bit_counter >=1 && bit_counter <= DATA_WIDTH) {
-                    // sample data bits LSB first
-                    bool b = rx_sync_1;
-                    shift_reg = (shift_reg >> 1) | ( (b?1:0) << (DATA_WIDTH-1) );
-                    bit_counter += 1;
-                    cycle_counter = 0;
-                } else if (bit_counter > DATA_WIDTH && bit_counter <= DATA_WIDTH + STOP_BITS) {
-                    // sample stop bit(s) - expecting high
-                    // if stop bit valid, finish
-                    bool b = rx_sync_1;
-                    if (b == true) {
-                        // produce data (note shift_reg contains MSB at position DATA_WIDTH-1)
-                        // convert to LSB-first ordering
-                        sc_uint<8> out = 0;
-                        for (int k = 0; k < DATA_WIDTH; ++k) {
-                            out[k] = shift_reg[DATA_WIDTH-1-k];
-                        }
-                        data_out.write(out);
-                        valid.write(true);
-                        // keep valid for one cycle; match original which asserts valid at stop
-                        // we'll clear valid when host accepts (ready)
-                        // reset sampling
-                        sampling = false;
-                        cycle_counter = 0;
-                        bit_counter = 0;
+            if (cycle_counter == offset(bit_counter, vote)) {
+                ones += b ? 1 : 0;
+                if (++vote == votes()) {
+                    const bool v = 2 * ones > votes();
+                    vote = 0;
+                    ones = 0;
+                    if (bit_counter == 0) {
+                        // start bit must still be low, else it was a glitch
+                        if (v) receiving = false;
+                        else   bit_counter = 1;
+                    } else if (bit_counter <= DATA_WIDTH) {
+                        // data bits LSB first
+                        shift_reg = (shift_reg >> 1) | ( (v?1:0) << (DATA_WIDTH-1) );
+                        bit_counter += 1;
                     } else {
-                        // framing error - ignore
-                        sampling = false;
+                        // first stop bit
+                        receiving = false;
+                        ended = true;
+                        stop_ok = v;
                     }
                 }
             }
         }
 
-        // clear valid if host ready
-        if (valid.read() && ready.read()) {
-            valid.write(false);
+        if (ended) frame_end(stop_ok, shift_reg);
+        else       finish_edge();
+
+        wait(); // posedge clk
+    }
+}
+
+// Edge that decides the stop bit: deliver the byte or flag a framing error
+void Uart_rx::frame_end(bool stop_ok, sc_uint<8> shift_reg) {
+    if (stop_ok) {
+        // bits came in LSB first from the top, so shift_reg holds the byte in order
+        data_out.write(shift_reg);
+        overrun_err.write(valid.read() && !ready.read());
+        framing_err.write(false);
+        write_valid(true);
+    } else {
+        framing_err.write(true);
+        overrun_err.write(false);
+        finish_edge();
+    }
+}
+
+// End of any other clk edge: valid drops once the host is ready
+void Uart_rx::finish_edge() {
+    if (valid.read() && ready.read()) {
+        write_valid(false);
+    }
+}
+
+// Event-driven mode. Produces the same outputs on the same clk edges (and
+// in the same delta) as the clocked loop. The synchronizer is a fixed delay,
+// so instead of shifting it every edge the thread reads rx SYNC_STAGES edges
+// ahead of where the clocked loop uses the value; only the stop bit's
+// outputs then wait for the edge the clocked loop writes them on. Between
+// sample points the thread sleeps, visiting other edges only to clear valid.
+// Always on a clk edge.
+void Uart_rx::rx_event_loop() {
+    if (sc_clock* c = dynamic_cast<sc_clock*>(clk.get_interface()))
+        clk_period = c->period();
+    else
+        clk_period = sc_time(1.0 / CLOCK_FREQ, SC_SEC);
+
+    while (true) {
+        if (!rst_n.read()) {
+            reset_rx();
+            wait(rst_n.posedge_event());
+            align_edge();
+            continue;
+        }
+
+        finish_edge();
+        if (rx.read()) {
+            // line idle
+            if (valid_q && ready.read()) {
+                wait(clk.posedge_event());
+            } else {
+                if (valid_q) wait(rx.negedge_event() | rst_n.negedge_event() | ready.posedge_event());
+                else         wait(rx.negedge_event() | rst_n.negedge_event());
+                align_edge();
+            }
+            continue;
+        }
+
+        // start bit on rx at this edge
+        rx_event_frame(sc_time_stamp());
+    }
+}
+
+// One frame whose start bit was on rx at `start`, plus any frame that
+// starts while the stop bit's outputs are still due. Returns on an edge the
+// main loop has not handled yet.
+void Uart_rx::rx_event_frame(sc_time start) {
+    while (true) {
+        sc_uint<8> shift_reg = 0;
+        bool stop_ok = false;
+
+        for (int j = 0; j <= DATA_WIDTH + 1; ++j) {
+            int ones = 0;
+            for (int v = 0; v < votes(); ++v) {
+                if (!skip_until(start + clk_period * offset(j, v))) return;
+                ones += rx.read() ? 1 : 0;
+                const bool last = j == DATA_WIDTH + 1 && v == votes() - 1;
+                if (!(last && SYNC_STAGES == 0)) finish_edge();
+            }
+            const bool b = 2 * ones > votes();
+            if (j == 0 && b) {
+                // glitch, not a start bit
+                skip_cycles(1);
+                return;
+            }
+            if (j >= 1 && j <= DATA_WIDTH) shift_reg = (shift_reg >> 1) | ( (b?1:0) << (DATA_WIDTH-1) );
+            if (j == DATA_WIDTH + 1) stop_ok = b;
+        }
+
+        // The clocked loop decides the stop bit SYNC_STAGES edges later;
+        // a new start bit may already show up on rx in between.
+        bool pending = false;
+        sc_time next_start;
+        for (int k = 0; k < SYNC_STAGES; ++k) {
+            if (!skip_cycles(1)) return;
+            if (!pending && !rx.read()) { pending = true; next_start = sc_time_stamp(); }
+            if (k < SYNC_STAGES - 1) finish_edge();
+        }
+        frame_end(stop_ok, shift_reg);
+
+        if (!pending) {
+            skip_cycles(1);
+            return;
+        }
+        start = next_start;
+    }
+}
+
+// Sleeps from the current edge to the edge at `until`: a timed wait to half
+// a cycle before it, then the edge itself. Edges in between are visited
+// only to clear valid. Returns false on the first edge with rst_n low.
+bool Uart_rx::skip_until(const sc_time& until) {
+    const sc_time before = until - clk_period / 2;
+
+    while (sc_time_stamp() < until) {
+        if (valid_q && ready.read()) {
+            wait(clk.posedge_event()); // valid drops on the next edge
+        } else if (sc_time_stamp() < before) {
+            if (valid_q) wait(before - sc_time_stamp(), rst_n.negedge_event() | ready.posedge_event());
+            else         wait(before - sc_time_stamp(), rst_n.negedge_event());
+            if (sc_time_stamp() < before) align_edge();
+            else wait(clk.posedge_event());
+        } else {
+            wait(clk.posedge_event());
         }
+        if (!rst_n.read()) return false;
+        if (sc_time_stamp() < until) finish_edge();
     }
+    return true;
 }
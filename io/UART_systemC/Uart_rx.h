@@ -8,6 +8,10 @@ SC_MODULE(Uart_rx) {
     int BAUD_RATE;
     int CLOCK_FREQ;
     int STOP_BITS;
+    int SYNC_STAGES; // flops between rx and the receiver (0: use rx directly)
+    int OVERSAMPLE;  // votes are CYCLES_PER_BIT/OVERSAMPLE cycles apart (8x, 16x)
+    bool MAJORITY;   // 2-of-3 vote around mid-bit instead of one mid-bit sample
+    bool EVENT_DRIVEN; // sleep between sample points instead of waking on every clk edge
 
     sc_in<bool> clk;
     sc_in<bool> rst_n;
@@ -18,11 +22,47 @@ SC_MODULE(Uart_rx) {
     sc_out<bool>         valid;
     sc_in<bool>          ready;
 
+    // Status of the last completed frame, held until the next one ends:
+    // framing_err  stop bit sampled low (no data delivered)
+    // overrun_err  byte delivered while the previous one was still unread
+    //              (it is overwritten)
+    sc_out<bool>         framing_err;
+    sc_out<bool>         overrun_err;
+
     int CYCLES_PER_BIT;
+    sc_time clk_period;
+    bool valid_q; // last value written to valid
+    unsigned sync_q; // synchronizer chain, bit k = stage k
 
     void rx_thread();
 
-    SC_CTOR(Uart_rx) : DATA_WIDTH(8), BAUD_RATE(9600), CLOCK_FREQ(50000000), STOP_BITS(1) {
+    // Sample points: vote v of bit j (0 = start bit, DATA_WIDTH+1 = stop
+    // bit) is taken offset(j, v) cycles after the edge that saw the start
+    // bit, as the synchronizer delivers it.
+    int votes() const { return MAJORITY ? 3 : 1; }
+    int vote_step() const {
+        const int os = OVERSAMPLE > 0 ? OVERSAMPLE : 1;
+        return MAJORITY ? (CYCLES_PER_BIT / os > 0 ? CYCLES_PER_BIT / os : 1) : 0;
+    }
+    int lead() const { return CYCLES_PER_BIT / 2 - vote_step() > 0 ? CYCLES_PER_BIT / 2 - vote_step() : 1; }
+    int offset(int j, int v) const { return j * CYCLES_PER_BIT + lead() + v * vote_step(); }
+
+    // Clocked and event-driven loops
+    void rx_clocked_loop();
+    void rx_event_loop();
+    void rx_event_frame(sc_time start);
+    bool sync_rx();
+    void reset_rx();
+    void frame_end(bool stop_ok, sc_uint<8> shift_reg);
+    void finish_edge();
+    bool skip_cycles(int n) { return skip_until(sc_time_stamp() + clk_period * n); }
+    bool skip_until(const sc_time& until);
+    void write_valid(bool v) { valid.write(v); valid_q = v; }
+    void align_edge() { if (!clk.posedge()) wait(clk.posedge_event()); }
+
+    SC_CTOR(Uart_rx) : DATA_WIDTH(8), BAUD_RATE(9600), CLOCK_FREQ(50000000), STOP_BITS(1),
+                       SYNC_STAGES(2), OVERSAMPLE(16), MAJORITY(true), EVENT_DRIVEN(false),
+                       valid_q(false), sync_q(~0u) {
         SC_THREAD(rx_thread);
         sensitive << clk.pos();
         dont_initialize();
@@ -32,6 +72,17 @@ SC_MODULE(Uart_rx) {
         DATA_WIDTH = data_width; BAUD_RATE = baud_rate; CLOCK_FREQ = clock_freq; STOP_BITS = stop_bits;
         CYCLES_PER_BIT = (CLOCK_FREQ + BAUD_RATE/2) / BAUD_RATE;
     }
+
+    // Synchronizer depth (0..32), oversampling factor and voting
+    void set_sampling(int sync_stages, int oversample=16, bool majority=true) {
+        SYNC_STAGES = sync_stages < 0 ? 0 : (sync_stages > 32 ? 32 : sync_stages);
+        OVERSAMPLE = oversample; MAJORITY = majority;
+    }
+
+    // Event-driven: same outputs, but the thread waits for the start edge
+    // on rx and then only wakes at the sample points (and on the edge that
+    // clears valid). Set before simulation starts.
+    void set_event_driven(bool on) { EVENT_DRIVEN = on; }
 };
 
 #endif // UART_RX_H
@@ -0,0 +1,49 @@
+#include "Uart_tlm.h"
+
+void Uart_tlm::tx_transport(tlm::tlm_generic_payload& gp, sc_time& delay) {
+    if (!gp.is_write() || gp.get_byte_enable_ptr()) {
+        gp.set_response_status(tlm::TLM_COMMAND_ERROR_RESPONSE);
+        return;
+    }
+    const unsigned n = gp.get_data_length();
+    if (n == 0) {
+        gp.set_response_status(tlm::TLM_OK_RESPONSE);
+        return;
+    }
+
+    // First start bit once both the caller and the line are ready
+    const sc_time now   = sc_time_stamp();
+    const sc_time start = (now + delay > tx_free) ? now + delay : tx_free;
+    tx_free = start + frame_time() * double(n);
+
+    line_gp.set_command(tlm::TLM_WRITE_COMMAND);
+    line_gp.set_address(0);
+    line_gp.set_data_ptr(gp.get_data_ptr());
+    line_gp.set_data_length(n);
+    line_gp.set_streaming_width(n);
+    line_gp.set_byte_enable_ptr(0);
+    line_gp.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+    sc_time t = start - now;
+    line_out->b_transport(line_gp, t);
+
+    delay = tx_free - now;
+    gp.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+// A burst arrives with its first start bit at now + delay; the receiver has
+// the last byte once it samples that byte's stop bit, half a bit in.
+void Uart_tlm::line_transport(tlm::tlm_generic_payload& gp, sc_time& delay) {
+    const unsigned n = gp.get_data_length();
+    gp.set_response_status(tlm::TLM_OK_RESPONSE);
+    if (n == 0) return;
+
+    rx_gp.set_command(tlm::TLM_WRITE_COMMAND);
+    rx_gp.set_address(0);
+    rx_gp.set_data_ptr(gp.get_data_ptr());
+    rx_gp.set_data_length(n);
+    rx_gp.set_streaming_width(n);
+    rx_gp.set_byte_enable_ptr(0);
+    rx_gp.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+    sc_time t = delay + frame_time() * double(n - 1) + bit_time() * (1 + DATA_WIDTH + 0.5);
+    rx_skt->b_transport(rx_gp, t);
+}
@@ -0,0 +1,65 @@
+#ifndef UART_TLM_H
+#define UART_TLM_H
+
+#include <systemc.h>
+#include <tlm.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/simple_target_socket.h>
+
+// Transaction-level UART. Same host-side view as Uart_bridge + Uart_core,
+// but frame timing is computed instead of clocked out bit by bit.
+//
+// Host side:
+//   tx_skt  (target)    write of N bytes = N frames to transmit. Frames go
+//                       back to back after any still on the line; the
+//                       delay comes back annotated to the end of the last
+//                       stop bit.
+//   rx_skt  (initiator) received bytes, one write per burst, annotated to
+//                       the middle of the last byte's stop bit (where the
+//                       receiver samples it)
+// Line side (the serial wire at TLM level):
+//   line_out (initiator) one write per tx burst, annotated to the start
+//                        bit of its first frame
+//   line_in  (target)    bursts from the far end (or line_out, for loopback)
+//
+// Everything is loosely timed: no wait() anywhere, callers sync as they like.
+SC_MODULE(Uart_tlm) {
+    int DATA_WIDTH;
+    int BAUD_RATE;
+    int CLOCK_FREQ;
+    int STOP_BITS;
+
+    tlm_utils::simple_target_socket<Uart_tlm>    tx_skt;
+    tlm_utils::simple_initiator_socket<Uart_tlm> rx_skt;
+    tlm_utils::simple_target_socket<Uart_tlm>    line_in;
+    tlm_utils::simple_initiator_socket<Uart_tlm> line_out;
+
+    int CYCLES_PER_BIT;
+
+    SC_CTOR(Uart_tlm) : DATA_WIDTH(8), BAUD_RATE(9600), CLOCK_FREQ(50000000), STOP_BITS(1),
+                        tx_skt("tx_skt"), rx_skt("rx_skt"), line_in("line_in"), line_out("line_out"),
+                        tx_free(SC_ZERO_TIME) {
+        tx_skt.register_b_transport(this, &Uart_tlm::tx_transport);
+        line_in.register_b_transport(this, &Uart_tlm::line_transport);
+        set_params(DATA_WIDTH, BAUD_RATE, CLOCK_FREQ, STOP_BITS);
+    }
+
+    void set_params(int data_width, int baud_rate, int clock_freq, int stop_bits=1) {
+        DATA_WIDTH = data_width; BAUD_RATE = baud_rate; CLOCK_FREQ = clock_freq; STOP_BITS = stop_bits;
+        CYCLES_PER_BIT = (CLOCK_FREQ + BAUD_RATE/2) / BAUD_RATE;
+    }
+
+    // One bit and one frame (start + data + stop) on the line
+    sc_time bit_time() const   { return sc_time(double(CYCLES_PER_BIT) / CLOCK_FREQ, SC_SEC); }
+    sc_time frame_time() const { return bit_time() * double(1 + DATA_WIDTH + STOP_BITS); }
+
+    void tx_transport(tlm::tlm_generic_payload& gp, sc_time& delay);
+    void line_transport(tlm::tlm_generic_payload& gp, sc_time& delay);
+
+private:
+    sc_time                  tx_free;  // when the last queued stop bit ends
+    tlm::tlm_generic_payload line_gp;
+    tlm::tlm_generic_payload rx_gp;
+};
+
+#endif // UART_TLM_H
@@ -16,6 +16,12 @@ void Uart_tx::tx_thread() {
     tx.write(true);
     ready.write(true);
 
+    if (EVENT_DRIVEN) {
+        wait(); // first posedge clk, as in the loop below
+        tx_event_loop();
+        return;
+    }
+
     while (true) {
         wait(); // wait for posedge clk
 
@@ -79,3 +85,81 @@ void Uart_tx::tx_thread() {
         }
     }
 }
+
+// Event-driven mode. Every step below happens on the same clk edge (and in
+// the same delta) as in the clocked loop above, so tx and ready are
+// identical; the thread just doesn't wake on the edges where nothing changes.
+// Always entered and left on a clk edge.
+void Uart_tx::tx_event_loop() {
+    if (sc_clock* c = dynamic_cast<sc_clock*>(clk.get_interface()))
+        clk_period = c->period();
+    else
+        clk_period = sc_time(1.0 / CLOCK_FREQ, SC_SEC);
+
+    while (true) {
+        if (!rst_n.read()) {
+            tx.write(true);
+            ready.write(true);
+            wait(rst_n.posedge_event());
+            align_edge();
+            continue;
+        }
+
+        ready.write(true);
+        if (!valid.read()) {
+            wait(valid.posedge_event() | rst_n.negedge_event());
+            align_edge();
+            continue;
+        }
+
+        send_frame(data_in.read());   // on reset, the next pass handles it
+    }
+}
+
+// Start bit, DATA_WIDTH data bits LSB first, STOP_BITS stop bits; returns on
+// the edge after the frame (where the clocked loop is idle again), or false
+// on the first edge that sees reset.
+bool Uart_tx::send_frame(sc_uint<8> shift_reg) {
+    // The clocked loop counts the start bit from 1, every other bit from 0
+    const int start_cycles = CYCLES_PER_BIT > 1 ? CYCLES_PER_BIT - 1 : 1;
+    const int bit_cycles   = CYCLES_PER_BIT > 0 ? CYCLES_PER_BIT : 1;
+
+    ready.write(false);
+    tx.write(false);
+    if (!skip_cycles(start_cycles)) return false;
+
+    for (int i = 0; i < DATA_WIDTH; ++i) {
+        tx.write( (shift_reg & 0x1) ? true : false );
+        shift_reg = shift_reg >> 1;
+        if (!skip_cycles(bit_cycles)) return false;
+    }
+
+    tx.write(true);
+    for (int i = 0; i < STOP_BITS; ++i) {
+        if (!skip_cycles(bit_cycles)) return false;
+    }
+
+    ready.write(true);
+    tx.write(true);
+    return skip_cycles(1);
+}
+
+// Sleeps from the current edge to the n-th next one: a timed wait to half a
+// cycle before it, then the edge itself. Returns false on the first edge
+// with rst_n low, which is where the clocked loop would have reset.
+bool Uart_tx::skip_cycles(int n) {
+    const sc_time until  = sc_time_stamp() + clk_period * n;
+    const sc_time before = until - clk_period / 2;
+
+    while (sc_time_stamp() < until) {
+        if (sc_time_stamp() < before) {
+            wait(before - sc_time_stamp(), rst_n.negedge_event());
+            if (sc_time_stamp() < before) align_edge(); // reset on the way: check it on its edge
+            else wait(clk.posedge_event());
+        } else {
+            wait(clk.posedge_event());
+        }
+        if (!rst_n.read()) return false;
+    }
+    return true;
+}
@@ -9,6 +9,7 @@ SC_MODULE(Uart_tx) {
     int BAUD_RATE;
     int CLOCK_FREQ;
     int STOP_BITS;
+    bool EVENT_DRIVEN; // sleep across a bit instead of waking on every clk edge
 
     // Ports
     sc_in<bool> clk;
@@ -22,10 +23,17 @@ SC_MODULE(Uart_tx) {
 
     // Internal
     int CYCLES_PER_BIT;
+    sc_time clk_period;
 
     void tx_thread();
 
-    SC_CTOR(Uart_tx) : DATA_WIDTH(8), BAUD_RATE(9600), CLOCK_FREQ(50000000), STOP_BITS(1) {
+    // Event-driven mode
+    void tx_event_loop();
+    bool send_frame(sc_uint<8> shift_reg);
+    bool skip_cycles(int n);
+    void align_edge() { if (!clk.posedge()) wait(clk.posedge_event()); }
+
+    SC_CTOR(Uart_tx) : DATA_WIDTH(8), BAUD_RATE(9600), CLOCK_FREQ(50000000), STOP_BITS(1), EVENT_DRIVEN(false) {
         SC_THREAD(tx_thread);
         sensitive << clk.pos();
         dont_initialize();
@@ -37,6 +45,11 @@ SC_MODULE(Uart_tx) {
         CYCLES_PER_BIT = (CLOCK_FREQ + BAUD_RATE/2) / BAUD_RATE;
     }
 
+    // Event-driven: same tx/ready waveform, but the thread only wakes at
+    // bit boundaries (plus a half-cycle lead-in to land on the clk edge).
+    // Set before simulation starts.
+    void set_event_driven(bool on) { EVENT_DRIVEN = on; }
+
 };
 
 #endif // UART_TX_H
@@ -0,0 +1,135 @@
+#include <systemc.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Uart_rx.h"
+
+// NCH independent Uart_rx instances in one simulation, each driven by its
+// own bit-banged line at a slightly different baud rate. Channels mix
+// synchronizer depth (0..3), 16x/8x oversampling, voting on/off and
+// clocked/event-driven mode, and some lines carry:
+//   i%4 == 1  a one-cycle spike in the middle of every bit (voted out)
+//   i%4 == 2  a short low pulse on the idle line (rejected as a start bit)
+//   i%8 == 6  two bytes with ready low: overrun_err, the second byte wins
+//   i%8 == 7  a frame with a low stop bit: framing_err, no byte
+// Every channel must receive exactly its own string.
+static const int NCH = 64;
+static const int BAUD = 115200;
+static const int CLOCK_FREQ = 50000000;
+
+int sc_main(int argc, char* argv[]) {
+    sc_clock clk("clk", 20, SC_NS); // 50 MHz
+    sc_signal<bool> rst_n;
+
+    sc_vector< sc_signal<bool> >         line("line", NCH), valid("valid", NCH), ready("ready", NCH);
+    sc_vector< sc_signal<bool> >         ferr("ferr", NCH), oerr("oerr", NCH);
+    sc_vector< sc_signal< sc_uint<8> > > data("data", NCH);
+
+    std::vector< std::unique_ptr<Uart_rx> > rxs;
+    for (int i = 0; i < NCH; ++i) {
+        rxs.emplace_back(new Uart_rx(("uart_rx" + std::to_string(i)).c_str()));
+        Uart_rx& r = *rxs.back();
+        r.clk(clk);
+        r.rst_n(rst_n);
+        r.rx(line[i]);
+        r.data_out(data[i]);
+        r.valid(valid[i]);
+        r.ready(ready[i]);
+        r.framing_err(ferr[i]);
+        r.overrun_err(oerr[i]);
+        r.set_params(8, BAUD, CLOCK_FREQ);
+        r.set_sampling(i % 4, (i / 4) % 2 ? 8 : 16, i % 4 != 3);
+        r.set_event_driven((i / 8) % 2 != 0);
+    }
+
+    int errors = 0;
+    std::vector<std::string> expect(NCH), received(NCH);
+    std::vector<int> ferr_seen(NCH, 0), oerr_seen(NCH, 0);
+    std::vector<bool> prev_ferr(NCH, false), prev_oerr(NCH, false);
+
+    // a byte is taken on the edge after a negedge with valid && ready
+    sc_spawn([&]{
+        while (true) {
+            wait(clk.negedge_event());
+            for (int i = 0; i < NCH; ++i) {
+                if (valid[i].read() && ready[i].read())
+                    received[i] += (char)data[i].read().to_uint();
+                if (ferr[i].read() && !prev_ferr[i]) ++ferr_seen[i];
+                if (oerr[i].read() && !prev_oerr[i]) ++oerr_seen[i];
+                prev_ferr[i] = ferr[i].read();
+                prev_oerr[i] = oerr[i].read();
+            }
+        }
+    });
+
+    for (int i = 0; i < NCH; ++i) {
+        sc_spawn([&, i]{
+            // -1.5% .. +1.5% baud error
+            const sc_time bit = sc_time(1.0 / (BAUD * (1.0 + 0.03 * ((i % 7) - 3) / 6)), SC_SEC);
+            const sc_time spike = sc_time(20, SC_NS);
+            const std::string msg = "RX" + std::to_string(i);
+
+            auto drive = [&](bool v) {
+                if (i % 4 != 1) { line[i].write(v); wait(bit); return; }
+                line[i].write(v);
+                wait(bit / 2);
+                line[i].write(!v);
+                wait(spike);
+                line[i].write(v);
+                wait(bit / 2 - spike);
+            };
+            auto send = [&](unsigned char ch, bool stop) {
+                drive(false);
+                for (int k = 0; k < 8; ++k) drive((ch >> k) & 1);
+                drive(stop);
+                line[i].write(true);
+                wait(bit * 2);
+            };
+
+            line[i].write(true);
+            ready[i].write(i % 8 != 6);
+            wait(200 + 37 * i, SC_NS);
+            if (i % 4 == 2) {
+                line[i].write(false);
+                wait(60, SC_NS);
+                line[i].write(true);
+                wait(bit);
+            }
+            if (i % 8 == 6) {
+                send('x', true);
+                send('y', true);
+                expect[i] += 'y';
+                ready[i].write(true);
+            }
+            if (i % 8 == 7) send('z', false);
+            for (char ch : msg) send((unsigned char)ch, true);
+            expect[i] += msg;
+        });
+    }
+
+    sc_spawn([&]{
+        rst_n.write(false);
+        wait(100, SC_NS);
+        rst_n.write(true);
+    });
+
+    sc_start(1, SC_MS);
+
+    for (int i = 0; i < NCH; ++i) {
+        const int want_f = i % 8 == 7, want_o = i % 8 == 6;
+        if (received[i] != expect[i] || ferr_seen[i] != want_f || oerr_seen[i] != want_o) {
+            std::cout << "TB: channel " << i << " received \"" << received[i] << "\", expected \"" << expect[i]
+                      << "\", framing " << ferr_seen[i] << "/" << want_f
+                      << ", overrun " << oerr_seen[i] << "/" << want_o << std::endl;
+            ++errors;
+        }
+        // a good frame clears both flags
+        if (ferr[i].read() || oerr[i].read()) {
+            std::cout << "TB: channel " << i << " error flag still set" << std::endl;
+            ++errors;
+        }
+    }
+    std::cout << "TB: " << NCH << " RX instances, " << errors << " failing" << std::endl;
+    std::cout << (errors ? "TB: FAIL" : "TB: PASS") << std::endl;
+    return errors ? 1 : 0;
+}
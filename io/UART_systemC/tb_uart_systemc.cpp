@@ -1,6 +1,8 @@
 #include <systemc.h>
+#include <cstring>
 #include "Uart_core.h"
 
+// tb_uart_systemc [--event]   --event: event-driven TX/RX instead of per-clock
 int sc_main(int argc, char* argv[]) {
     sc_clock clk("clk", 20, SC_NS); // 50 MHz
     sc_signal<bool> rst_n;
@@ -15,6 +17,8 @@ int sc_main(int argc, char* argv[]) {
     sc_signal< sc_uint<8> > rx_data;
     sc_signal<bool> rx_valid;
     sc_signal<bool> rx_ready;
+    sc_signal<bool> rx_framing_err;
+    sc_signal<bool> rx_overrun_err;
 
     // instantiate core
     Uart_core core("uart_core");
@@ -24,10 +28,13 @@ int sc_main(int argc, char* argv[]) {
     core.rx_data(rx_data);
     core.rx_valid(rx_valid);
     core.rx_ready(rx_ready);
+    core.rx_framing_err(rx_framing_err);
+    core.rx_overrun_err(rx_overrun_err);
     core.tx(uart_tx);
     core.tx_data(tx_data);
     core.tx_valid(tx_valid);
     core.tx_ready(tx_ready);
+    if (argc > 1 && !std::strcmp(argv[1], "--event")) core.set_event_driven(true);
 
     // loopback: connect tx -> rx
     // use small delay via an SC_THREAD
@@ -14,44 +14,102 @@ struct Memory : sc_core::sc_module {
 
   Memory(sc_core::sc_module_name n,
          size_t words,
-         sc_core::sc_time latency = sc_core::sc_time(10, sc_core::SC_NS))
-    : sc_module(n), mem_(words, 0), latency_(latency) {
+         sc_core::sc_time latency = sc_core::sc_time(10, sc_core::SC_NS),
+         bool allow_dmi = true)
+    : sc_module(n), mem_(words, 0), latency_(latency), allow_dmi_(allow_dmi) {
     tsock.register_b_transport(this, &Memory::b_transport);
+    tsock.register_get_direct_mem_ptr(this, &Memory::get_direct_mem_ptr);
+    tsock.register_transport_dbg(this, &Memory::transport_dbg);
   }
 
+  // Word-aligned accesses of one or more whole words; each word costs one
+  // `latency` and each written word is published on data_ap.
   void b_transport(tlm::tlm_generic_payload& trans, sc_core::sc_time& delay) {
     auto cmd  = trans.get_command();
     auto addr = trans.get_address();
     auto* ptr = trans.get_data_ptr();
     auto  len = trans.get_data_length();
 
-    // Basic checks (word aligned, 4-byte access, address range)
-    if ((addr & 0x3) != 0 || len != 4 || (addr >> 2) >= mem_.size()) {
+    if (!in_range(addr, len)) {
       trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
       return;
     }
+    if (trans.get_byte_enable_ptr() != nullptr) {
+      trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+      return;
+    }
+    if (trans.get_streaming_width() < len) {
+      trans.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+      return;
+    }
 
-    delay += latency_;
-    uint32_t& reg = mem_[addr >> 2];
+    const size_t words = len / 4;
+    delay += latency_ * static_cast<double>(words);
+    uint32_t* reg = &mem_[addr >> 2];
 
     if (cmd == tlm::TLM_WRITE_COMMAND) {
-      uint32_t val;
-      std::memcpy(&val, ptr, sizeof(val));
-      reg = val;
+      std::memcpy(reg, ptr, len);
 
       // Publish to analysis port for the counter IP
-      data_ap.write(val);
+      for (size_t i = 0; i < words; ++i) data_ap.write(reg[i]);
 
       trans.set_response_status(tlm::TLM_OK_RESPONSE);
     } else if (cmd == tlm::TLM_READ_COMMAND) {
-      std::memcpy(ptr, &reg, sizeof(reg));
+      std::memcpy(ptr, reg, len);
       trans.set_response_status(tlm::TLM_OK_RESPONSE);
     } else {
       trans.set_response_status(tlm::TLM_COMMAND_ERROR_RESPONSE);
+      return;
     }
+
+    // Hint to the initiator that it may bypass b_transport from now on
+    trans.set_dmi_allowed(allow_dmi_);
+  }
+
+  // Grants read/write access to the whole array. The latencies are per
+  // word, matching what b_transport would have annotated. Writes made
+  // through the pointer are not published on data_ap; an initiator that
+  // uses DMI is responsible for reporting its own writes.
+  bool get_direct_mem_ptr(tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi) {
+    if (!allow_dmi_ || mem_.empty()) return false;
+
+    dmi.set_dmi_ptr(reinterpret_cast<unsigned char*>(mem_.data()));
+    dmi.set_start_address(0);
+    dmi.set_end_address(mem_.size() * 4 - 1);
+    dmi.set_granted_access(tlm::tlm_dmi::DMI_ACCESS_READ_WRITE);
+    dmi.set_read_latency(latency_);
+    dmi.set_write_latency(latency_);
+    (void)trans;
+    return true;
+  }
+
+  // Debug access: same checks as b_transport, no timing, no publishing
+  unsigned transport_dbg(tlm::tlm_generic_payload& trans) {
+    auto addr = trans.get_address();
+    auto len  = trans.get_data_length();
+    if (!in_range(addr, len)) return 0;
+
+    auto* reg = reinterpret_cast<unsigned char*>(&mem_[addr >> 2]);
+    if (trans.is_write())     std::memcpy(reg, trans.get_data_ptr(), len);
+    else if (trans.is_read()) std::memcpy(trans.get_data_ptr(), reg, len);
+    else return 0;
+    return len;
+  }
+
+  // Revokes all outstanding DMI pointers (and refuses new ones until
+  // enable_dmi(true)); call before changing the memory behind them.
+  void enable_dmi(bool on) {
+    allow_dmi_ = on;
+    if (!on) tsock->invalidate_direct_mem_ptr(0, mem_.size() * 4 - 1);
   }
 
 private:
+  bool in_range(sc_dt::uint64 addr, unsigned len) const {
+    return (addr & 0x3) == 0 && len != 0 && (len & 0x3) == 0 &&
+           (addr >> 2) < mem_.size() && (len >> 2) <= mem_.size() - (addr >> 2);
+  }
+
   std::vector<uint32_t> mem_;
   sc_core::sc_time      latency_;
+  bool                  allow_dmi_;
 };
@@ -2,25 +2,35 @@
 #include <systemc>
 #include <tlm>
 #include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/tlm_quantumkeeper.h>
 #include <random>
 #include <cstdint>
+#include <cstring>
 
 struct RandomGen : sc_core::sc_module {
   tlm_utils::simple_initiator_socket<RandomGen> isock{"isock"};
+  // Items written through DMI never reach the target's b_transport, so they
+  // are published here instead (bind alongside the target's own port).
+  tlm::tlm_analysis_port<uint32_t>              dmi_ap{"dmi_ap"};
 
   SC_HAS_PROCESS(RandomGen);
 
   RandomGen(sc_core::sc_module_name n,
             unsigned num_items,
             uint32_t seed = 0xC0FFEEu,
-            sc_core::sc_time issue_period = sc_core::sc_time(20, sc_core::SC_NS))
+            sc_core::sc_time issue_period = sc_core::sc_time(20, sc_core::SC_NS),
+            bool use_dmi = true)
     : sc_module(n),
       num_items_(num_items),
       rng_(seed),
-      period_(issue_period) {
+      period_(issue_period),
+      use_dmi_(use_dmi) {
+    isock.register_invalidate_direct_mem_ptr(this, &RandomGen::invalidate_direct_mem_ptr);
     SC_THREAD(generate_thread);
   }
 
+  uint64_t dmi_items() const { return dmi_items_; }
+
 private:
   void generate_thread() {
     std::uniform_int_distribution<uint32_t> dist(0, 0xFFFFFFFFu);
@@ -28,36 +38,79 @@ private:
     tlm::tlm_generic_payload trans;
     sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
 
+    // Loosely timed: the generator runs ahead of simulation time by up to
+    // the global quantum (tlm_global_quantum) and only yields to the kernel
+    // when it is used up. A zero quantum yields after every item.
+    qk_.reset();
+
     for (unsigned i = 0; i < num_items_; ++i) {
       uint32_t data = dist(rng_);
+      const sc_dt::uint64 addr = static_cast<sc_dt::uint64>(i * 4); // word address
+      const sc_core::sc_time local = qk_.get_local_time();
+      delay = local;
 
-      // Prepare a blocking WRITE
-      trans.set_command(tlm::TLM_WRITE_COMMAND);
-      trans.set_address(static_cast<sc_dt::uint64>(i * 4)); // word address
-      trans.set_data_length(4);
-      trans.set_streaming_width(4);
-      trans.set_byte_enable_ptr(nullptr);
-      trans.set_dmi_allowed(false);
-      trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+      if (dmi_valid_ && addr >= dmi_.get_start_address() &&
+          addr + 3 <= dmi_.get_end_address()) {
+        // Fast path: straight into the target's storage
+        std::memcpy(dmi_.get_dmi_ptr() + (addr - dmi_.get_start_address()),
+                    &data, sizeof(data));
+        delay += dmi_.get_write_latency();
+        dmi_ap.write(data);
+        ++dmi_items_;
+      } else {
+        // Prepare a blocking WRITE
+        trans.set_command(tlm::TLM_WRITE_COMMAND);
+        trans.set_address(addr);
+        trans.set_data_length(4);
+        trans.set_streaming_width(4);
+        trans.set_byte_enable_ptr(nullptr);
+        trans.set_dmi_allowed(false);
+        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
 
-      auto* dp = reinterpret_cast<unsigned char*>(&data);
-      trans.set_data_ptr(dp);
+        auto* dp = reinterpret_cast<unsigned char*>(&data);
+        trans.set_data_ptr(dp);
 
-      delay = sc_core::SC_ZERO_TIME;
-      isock->b_transport(trans, delay);
+        isock->b_transport(trans, delay);
 
-      if (trans.get_response_status() != tlm::TLM_OK_RESPONSE) {
-        SC_REPORT_ERROR("/RandomGen", "Transaction failed");
+        if (trans.get_response_status() != tlm::TLM_OK_RESPONSE) {
+          SC_REPORT_ERROR("/RandomGen", "Transaction failed");
+        }
+
+        // The target offered DMI: ask for a pointer once, use it from then on
+        if (use_dmi_ && trans.is_dmi_allowed() && !dmi_valid_) {
+          dmi_.init();
+          dmi_valid_ = isock->get_direct_mem_ptr(trans, dmi_) && dmi_.is_write_allowed();
+        }
       }
 
-      wait(period_);
+      // Issue is pipelined: an access only stalls the generator when its
+      // latency exceeds the issue period.
+      const sc_core::sc_time latency = delay - local;
+      const sc_core::sc_time step    = latency > period_ ? latency : period_;
+      if (step != sc_core::SC_ZERO_TIME) {
+        qk_.inc(step);
+        if (qk_.need_sync()) qk_.sync();
+      }
     }
+    qk_.sync();
 
     std::cout << "\n[RandomGen] Finished generating " << num_items_
-              << " items at " << sc_core::sc_time_stamp() << "\n";
+              << " items at " << sc_core::sc_time_stamp()
+              << " (" << dmi_items_ << " via DMI)\n";
+  }
+
+  void invalidate_direct_mem_ptr(sc_dt::uint64 start, sc_dt::uint64 end) {
+    if (dmi_valid_ && start <= dmi_.get_end_address() && end >= dmi_.get_start_address()) {
+      dmi_valid_ = false;
+    }
   }
 
-  unsigned           num_items_;
-  std::mt19937       rng_;
-  sc_core::sc_time   period_;
+  unsigned                     num_items_;
+  std::mt19937                 rng_;
+  sc_core::sc_time             period_;
+  bool                         use_dmi_;
+  tlm_utils::tlm_quantumkeeper qk_;
+  tlm::tlm_dmi                 dmi_;
+  bool                         dmi_valid_{false};
+  uint64_t                     dmi_items_{0};
 };
@@ -18,5 +18,7 @@ struct Top : sc_core::sc_module {
     gen.isock.bind(mem.tsock);
     // Memory publishes each written datum to the counter
     mem.data_ap.bind(cnt.analysis_export);
+    // ...and the generator publishes what it writes through DMI
+    gen.dmi_ap.bind(cnt.analysis_export);
   }
 };
@@ -0,0 +1,50 @@
+// Generator -> Memory throughput with and without DMI.
+//
+//   soc_example_bench_dmi [items] [dmi|nodmi]
+//
+// Latency and issue period are zero so the generator never yields and the
+// wall-clock time is the cost of the access path itself. One mode per run
+// (a SystemC process elaborates once); `make bench_dmi` runs both.
+
+#include <systemc>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "RandomGen.h"
+#include "Memory.h"
+#include "Counter.h"
+
+struct BenchTop : sc_core::sc_module {
+  RandomGen gen;
+  Memory    mem;
+  Counter   cnt;
+
+  BenchTop(sc_core::sc_module_name n, unsigned items, bool dmi)
+    : sc_module(n),
+      gen("gen", items, /*seed=*/0x1234u, sc_core::SC_ZERO_TIME, dmi),
+      mem("mem", /*words=*/items, sc_core::SC_ZERO_TIME),
+      cnt("counter")
+  {
+    gen.isock.bind(mem.tsock);
+    mem.data_ap.bind(cnt.analysis_export);
+    gen.dmi_ap.bind(cnt.analysis_export);
+  }
+};
+
+int sc_main(int argc, char* argv[]) {
+  const unsigned items = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 0)) : 1000000u;
+  const bool     dmi   = argc > 2 ? std::strcmp(argv[2], "nodmi") != 0 : true;
+
+  BenchTop top("Top", items, dmi);
+
+  const auto t0 = std::chrono::steady_clock::now();
+  sc_core::sc_start();
+  const auto t1 = std::chrono::steady_clock::now();
+
+  const double secs = std::chrono::duration<double>(t1 - t0).count();
+  std::cout << "\n[BENCH] " << (dmi ? "dmi  " : "nodmi") << " items=" << items
+            << " dmi_items=" << top.gen.dmi_items()
+            << " time=" << secs << "s"
+            << " items/sec=" << (secs > 0 ? items / secs : 0.0) << "\n";
+  return 0;
+}
@@ -1,8 +1,15 @@
 #include <systemc>
+#include <tlm_utils/tlm_quantumkeeper.h>
+#include <cstdlib>
 #include "Top.h"
 
+// soc_example [quantum_ns]
+//   quantum_ns: global quantum for the loosely-timed initiators (default 0,
+//   i.e. synchronize after every transaction).
 int sc_main(int argc, char* argv[]) {
-  (void)argc; (void)argv;
+  const double quantum_ns = argc > 1 ? std::strtod(argv[1], nullptr) : 0.0;
+  tlm_utils::tlm_quantumkeeper::set_global_quantum(sc_core::sc_time(quantum_ns, sc_core::SC_NS));
+
   Top top("Top");
   sc_core::sc_start(sc_core::sc_time(1, sc_core::SC_MS));
   std::cout << "\n[SC_MAIN] Finished at " << sc_core::sc_time_stamp() << "\n";
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "vkit/agent.hpp"
+#include "vkit/bus_master.hpp"
+#include "vkit/pool.hpp"
+#include "vkit/suite_bin.hpp"
+#include "vkit/utils/json.hpp"
+#include "soc/ip/axi_dma.h"
 #include <systemc>
+#include <charconv>
 #include <cstdint>
 #include <string>
 
 namespace items {
 struct dma_burst : vkit::sequence_item {
+  static constexpr const char* type_name = "dma_burst";
   std::uint64_t src{0};
   std::uint64_t dst{0};
   std::uint32_t len{0};
@@ -14,20 +21,56 @@ struct dma_burst : vkit::sequence_item {
 } // namespace items
 
 struct axi_dma_driver : vkit::driver_if {
+  explicit axi_dma_driver(vkit::bus_master& regs) : regs_(regs) {}
+
   void drive(const vkit::sequence_item& base) override {
-    auto& it = static_cast<const items::dma_burst&>(base);
-    std::string msg = "DMA burst: src=0x" + to_hex(it.src) +
-                      " dst=0x" + to_hex(it.dst) +
-                      " len="   + std::to_string(it.len);
-    SC_REPORT_INFO("axi_dma_driver", msg.c_str());
+    const auto& it = static_cast<const items::dma_burst&>(base);
+    program(it);
+    log_.clear();
+    format(it);
+    SC_REPORT_INFO("axi_dma_driver", log_.c_str());
+  }
+
+  // One report for the whole batch instead of one per item
+  void drive_batch(vkit::item_span batch) override {
+    log_.clear();
+    for (const auto* base : batch) {
+      const auto& it = static_cast<const items::dma_burst&>(*base);
+      program(it);
+      if (!log_.empty()) log_ += '\n';
+      format(it);
+    }
+    if (!log_.empty()) SC_REPORT_INFO("axi_dma_driver", log_.c_str());
   }
 
 private:
-  static std::string to_hex(std::uint64_t v) {
-    std::ostringstream oss;
-    oss << std::hex << v;
-    return oss.str();
+  // SRC/DST/LEN as one block write, then CTRL.start
+  void program(const items::dma_burst& it) {
+    const std::uint32_t r[5] = {
+      static_cast<std::uint32_t>(it.src), static_cast<std::uint32_t>(it.src >> 32),
+      static_cast<std::uint32_t>(it.dst), static_cast<std::uint32_t>(it.dst >> 32),
+      it.len};
+    regs_.write_block(axi_dma::SRC_LO, r, 5);
+    regs_.write32(axi_dma::CTRL, 1u);
+  }
+
+  void format(const items::dma_burst& it) {
+    log_ += "DMA burst: src=0x";
+    append_hex(it.src);
+    log_ += " dst=0x";
+    append_hex(it.dst);
+    log_ += " len=";
+    log_ += std::to_string(it.len);
+  }
+
+  void append_hex(std::uint64_t v) {
+    char buf[16];
+    auto res = std::to_chars(buf, buf + sizeof(buf), v, 16);
+    log_.append(buf, res.ptr);
   }
+
+  vkit::bus_master& regs_;
+  std::string log_;   // reused across batches
 };
 
 struct axi_dma_monitor : vkit::monitor_if {
@@ -51,7 +94,7 @@ struct axi_dma_agent : vkit::agent {
   explicit axi_dma_agent(sc_core::sc_module_name nm)
     : vkit::agent(nm)
   {
-    d = std::make_unique<axi_dma_driver>();
+    d = std::make_unique<axi_dma_driver>(regs);
     m = std::make_unique<axi_dma_monitor>();
     s = std::make_unique<axi_dma_scoreboard>();
   }
@@ -59,4 +102,22 @@ struct axi_dma_agent : vkit::agent {
   vkit::driver_if*    driver()    override { return d.get(); }
   vkit::monitor_if*   monitor()   override { return m.get(); }
   vkit::scoreboard_if*scoreboard()override { return s.get(); }
+
+  // Vector decoders, registered with env next to the factory entry. Items
+  // come from a recycling pool and are reused once it has warmed up.
+  static vkit::item_ptr from_json(const nlohmann::json& v) {
+    return vkit::item_pool<items::dma_burst>::instance().make([&](items::dma_burst& p) {
+      p.len = v.value("len", 0u);
+      p.src = v.at("src").get<std::uint64_t>();
+      p.dst = v.at("dst").get<std::uint64_t>();
+    });
+  }
+
+  static vkit::item_ptr from_bin(vkit::bin_cursor& r) {
+    return vkit::item_pool<items::dma_burst>::instance().make([&](items::dma_burst& p) {
+      p.len = r.u32();
+      p.src = r.u64();
+      p.dst = r.u64();
+    });
+  }
 };
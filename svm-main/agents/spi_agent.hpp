@@ -1,24 +1,69 @@
 #pragma once
 
 #include "vkit/agent.hpp"
+#include "vkit/bus_master.hpp"
+#include "vkit/pool.hpp"
+#include "vkit/suite_bin.hpp"
+#include "vkit/utils/json.hpp"
+#include "soc/ip/spi.h"
 #include <systemc>
 #include <vector>
 #include <string>
 
 namespace items {
 struct spi_xfer : vkit::sequence_item {
+  static constexpr const char* type_name = "spi_xfer";
   unsigned mode{0};
   std::vector<std::uint8_t> tx;
+
+  spi_xfer() { tx.reserve(64); }
+  std::size_t capacity() const { return tx.capacity(); }
 };
 } // namespace items
 
 struct spi_driver : vkit::driver_if {
+  explicit spi_driver(vkit::bus_master& regs) : regs_(regs) {}
+
   void drive(const vkit::sequence_item& base) override {
-    auto& it = static_cast<const items::spi_xfer&>(base);
-    std::string msg = "SPI XFER: mode=" + std::to_string(it.mode) +
-                      " len=" + std::to_string(it.tx.size());
-    SC_REPORT_INFO("spi_driver", msg.c_str());
+    const auto& it = static_cast<const items::spi_xfer&>(base);
+    program(it);
+    log_.clear();
+    format(it);
+    SC_REPORT_INFO("spi_driver", log_.c_str());
+  }
+
+  // One report for the whole batch instead of one per item
+  void drive_batch(vkit::item_span batch) override {
+    log_.clear();
+    for (const auto* base : batch) {
+      const auto& it = static_cast<const items::spi_xfer&>(*base);
+      program(it);
+      if (!log_.empty()) log_ += '\n';
+      format(it);
+    }
+    if (!log_.empty()) SC_REPORT_INFO("spi_driver", log_.c_str());
   }
+
+private:
+  // MODE, TX bytes streamed into TXDATA, loopback drained from RXDATA
+  void program(const items::spi_xfer& it) {
+    const unsigned n = static_cast<unsigned>(it.tx.size());
+    regs_.write32(spi::MODE, it.mode);
+    regs_.write_stream(spi::TXDATA, it.tx.data(), n);
+    rx_.resize(n);
+    regs_.read_stream(spi::RXDATA, rx_.data(), n);
+  }
+
+  void format(const items::spi_xfer& it) {
+    log_ += "SPI XFER: mode=";
+    log_ += std::to_string(it.mode);
+    log_ += " len=";
+    log_ += std::to_string(it.tx.size());
+  }
+
+  vkit::bus_master& regs_;
+  std::string log_;   // reused across batches
+  std::vector<std::uint8_t> rx_;   // RXDATA drain buffer
 };
 
 struct spi_monitor : vkit::monitor_if {
@@ -42,7 +87,7 @@ struct spi_agent : vkit::agent {
   explicit spi_agent(sc_core::sc_module_name nm)
     : vkit::agent(nm)
   {
-    d = std::make_unique<spi_driver>();
+    d = std::make_unique<spi_driver>(regs);
     m = std::make_unique<spi_monitor>();
     s = std::make_unique<spi_scoreboard>();
   }
@@ -50,4 +95,27 @@ struct spi_agent : vkit::agent {
   vkit::driver_if*    driver()    override { return d.get(); }
   vkit::monitor_if*   monitor()   override { return m.get(); }
   vkit::scoreboard_if*scoreboard()override { return s.get(); }
+
+  // Vector decoders, registered with env next to the factory entry. Items
+  // come from a recycling pool and are reused once it has warmed up.
+  static vkit::item_ptr from_json(const nlohmann::json& v) {
+    return vkit::item_pool<items::spi_xfer>::instance().make([&](items::spi_xfer& p) {
+      p.mode = v.value("mode", 0u);
+      p.tx.clear();
+      if (v.contains("tx")) {
+        for (const auto& b : v["tx"]) {
+          p.tx.push_back(static_cast<std::uint8_t>(b.get<int>()));
+        }
+      }
+    });
+  }
+
+  static vkit::item_ptr from_bin(vkit::bin_cursor& r) {
+    return vkit::item_pool<items::spi_xfer>::instance().make([&](items::spi_xfer& p) {
+      p.mode = r.u32();
+      const std::uint32_t n = r.u32();
+      const std::uint8_t* b = r.bytes(n);
+      if (b) p.tx.assign(b, b + n); else p.tx.clear();
+    });
+  }
 };
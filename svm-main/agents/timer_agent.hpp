@@ -1,25 +1,61 @@
 #pragma once
 
 #include "vkit/agent.hpp"
+#include "vkit/bus_master.hpp"
+#include "vkit/pool.hpp"
+#include "vkit/suite_bin.hpp"
+#include "vkit/utils/json.hpp"
+#include "soc/ip/timer.h"
 #include <systemc>
 #include <cstdint>
 
 namespace items {
 struct timer_cmd : vkit::sequence_item {
+  static constexpr const char* type_name = "timer_cmd";
   bool     start{true};
   unsigned period_us{10};
 };
 } // namespace items
 
 struct timer_driver : vkit::driver_if {
+  explicit timer_driver(vkit::bus_master& regs) : regs_(regs) {}
+
   // This driver is logical  it just logs actions for now.
   void drive(const vkit::sequence_item& base) override {
-    auto& it = static_cast<const items::timer_cmd&>(base);
-    std::string msg = std::string("Timer cmd: ") +
-                      (it.start ? "start" : "stop") +
-                      " period_us=" + std::to_string(it.period_us);
-    SC_REPORT_INFO("timer_driver", msg.c_str());
+    const auto& it = static_cast<const items::timer_cmd&>(base);
+    program(it);
+    log_.clear();
+    format(it);
+    SC_REPORT_INFO("timer_driver", log_.c_str());
+  }
+
+  // One report for the whole batch instead of one per item
+  void drive_batch(vkit::item_span batch) override {
+    log_.clear();
+    for (const auto* base : batch) {
+      const auto& it = static_cast<const items::timer_cmd&>(*base);
+      program(it);
+      if (!log_.empty()) log_ += '\n';
+      format(it);
+    }
+    if (!log_.empty()) SC_REPORT_INFO("timer_driver", log_.c_str());
+  }
+
+private:
+  void program(const items::timer_cmd& it) {
+    if (it.start) regs_.write32(timer::PERIOD_US, it.period_us);
+    regs_.write32(timer::CTRL, it.start ? 1u : 0u);
+  }
+
+  void format(const items::timer_cmd& it) {
+    log_ += "Timer cmd: ";
+    log_ += it.start ? "start" : "stop";
+    log_ += " period_us=";
+    log_ += std::to_string(it.period_us);
   }
+
+  vkit::bus_master& regs_;
+  std::string log_;   // reused across batches
 };
 
 struct timer_monitor : vkit::monitor_if {
@@ -43,7 +79,7 @@ struct timer_agent : vkit::agent {
   explicit timer_agent(sc_core::sc_module_name nm)
     : vkit::agent(nm)
   {
-    d = std::make_unique<timer_driver>();
+    d = std::make_unique<timer_driver>(regs);
     m = std::make_unique<timer_monitor>();
     s = std::make_unique<timer_scoreboard>();
   }
@@ -51,4 +87,20 @@ struct timer_agent : vkit::agent {
   vkit::driver_if*    driver()    override { return d.get(); }
   vkit::monitor_if*   monitor()   override { return m.get(); }
   vkit::scoreboard_if*scoreboard()override { return s.get(); }
+
+  // Vector decoders, registered with env next to the factory entry. Items
+  // come from a recycling pool and are reused once it has warmed up.
+  static vkit::item_ptr from_json(const nlohmann::json& v) {
+    return vkit::item_pool<items::timer_cmd>::instance().make([&](items::timer_cmd& p) {
+      p.start     = v.value("op", std::string("start")) == "start";
+      p.period_us = v.value("period_us", 10u);
+    });
+  }
+
+  static vkit::item_ptr from_bin(vkit::bin_cursor& r) {
+    return vkit::item_pool<items::timer_cmd>::instance().make([&](items::timer_cmd& p) {
+      p.start     = r.u8() != 0;
+      p.period_us = r.u32();
+    });
+  }
 };
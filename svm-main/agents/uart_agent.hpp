@@ -1,27 +1,74 @@
 #pragma once
 
 #include "vkit/agent.hpp"
+#include "vkit/bus_master.hpp"
+#include "vkit/pool.hpp"
+#include "vkit/suite_bin.hpp"
+#include "vkit/utils/json.hpp"
+#include "soc/ip/uart.h"
 #include <systemc>
 #include <vector>
 #include <string>
 
 namespace items {
+// Values are the CTRL[1:0] encoding and the suite.bin parity byte
+enum class uart_parity : std::uint8_t { none = 0, even = 1, odd = 2 };
+
 struct uart_tx : vkit::sequence_item {
+  static constexpr const char* type_name = "uart_tx";
   std::uint32_t baud{115200};
   std::vector<std::uint8_t> payload;
-  bool parity{false};
+  uart_parity parity{uart_parity::none};
+
+  uart_tx() { payload.reserve(256); }
+  std::size_t capacity() const { return payload.capacity(); }
 };
 } // namespace items
 
 struct uart_driver : vkit::driver_if {
+  explicit uart_driver(vkit::bus_master& regs) : regs_(regs) {}
+
   void drive(const vkit::sequence_item& base) override {
-    auto& it = static_cast<const items::uart_tx&>(base);
-    std::string s(it.payload.begin(), it.payload.end());
-    std::string msg = "UART TX: baud=" + std::to_string(it.baud) +
-                      " len=" + std::to_string(it.payload.size()) +
-                      " data=\"" + s + "\"";
-    SC_REPORT_INFO("uart_driver", msg.c_str());
+    const auto& it = static_cast<const items::uart_tx&>(base);
+    program(it);
+    log_.clear();
+    format(it);
+    SC_REPORT_INFO("uart_driver", log_.c_str());
+  }
+
+  // One report for the whole batch instead of one per item
+  void drive_batch(vkit::item_span batch) override {
+    log_.clear();
+    for (const auto* base : batch) {
+      const auto& it = static_cast<const items::uart_tx&>(*base);
+      program(it);
+      if (!log_.empty()) log_ += '\n';
+      format(it);
+    }
+    if (!log_.empty()) SC_REPORT_INFO("uart_driver", log_.c_str());
+  }
+
+private:
+  // BAUD/CTRL, then the payload streamed into TXDATA in one burst
+  void program(const items::uart_tx& it) {
+    regs_.write32(uart::BAUD, it.baud);
+    regs_.write32(uart::CTRL, static_cast<std::uint32_t>(it.parity));
+    regs_.write_stream(uart::TXDATA, it.payload.data(),
+                       static_cast<unsigned>(it.payload.size()));
   }
+
+  void format(const items::uart_tx& it) {
+    log_ += "UART TX: baud=";
+    log_ += std::to_string(it.baud);
+    log_ += " len=";
+    log_ += std::to_string(it.payload.size());
+    log_ += " data=\"";
+    log_.append(it.payload.begin(), it.payload.end());
+    log_ += '"';
+  }
+
+  vkit::bus_master& regs_;
+  std::string log_;   // reused across batches
 };
 
 struct uart_monitor : vkit::monitor_if {
@@ -48,7 +95,7 @@ struct uart_agent : vkit::agent {
   explicit uart_agent(sc_core::sc_module_name nm)
     : vkit::agent(nm)
   {
-    d = std::make_unique<uart_driver>();
+    d = std::make_unique<uart_driver>(regs);
     m = std::make_unique<uart_monitor>();
     s = std::make_unique<uart_scoreboard>();
   }
@@ -56,4 +103,34 @@ struct uart_agent : vkit::agent {
   vkit::driver_if*    driver()    override { return d.get(); }
   vkit::monitor_if*   monitor()   override { return m.get(); }
   vkit::scoreboard_if*scoreboard()override { return s.get(); }
+
+  // Vector decoders, registered with env next to the factory entry. Items
+  // come from a recycling pool and are reused once it has warmed up.
+  static vkit::item_ptr from_json(const nlohmann::json& v) {
+    return vkit::item_pool<items::uart_tx>::instance().make([&](items::uart_tx& p) {
+      p.baud   = v.value("baud", 115200u);
+      // "none", "even" or "odd"; anything else is none, as in tools/suite2bin
+      const std::string parity = v.value("parity", std::string("none"));
+      p.parity = parity == "even" ? items::uart_parity::even
+               : parity == "odd"  ? items::uart_parity::odd
+                                  : items::uart_parity::none;
+      p.payload.clear();
+      if (v.contains("payload")) {
+        for (const auto& b : v["payload"]) {
+          p.payload.push_back(static_cast<std::uint8_t>(b.get<int>()));
+        }
+      }
+    });
+  }
+
+  static vkit::item_ptr from_bin(vkit::bin_cursor& r) {
+    return vkit::item_pool<items::uart_tx>::instance().make([&](items::uart_tx& p) {
+      p.baud   = r.u32();
+      const std::uint8_t parity = r.u8();
+      p.parity = parity <= 2 ? static_cast<items::uart_parity>(parity) : items::uart_parity::none;
+      const std::uint32_t n = r.u32();
+      const std::uint8_t* b = r.bytes(n);
+      if (b) p.payload.assign(b, b + n); else p.payload.clear();
+    });
+  }
 };
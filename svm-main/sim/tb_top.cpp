@@ -1,5 +1,6 @@
 #include <systemc>
 #include <filesystem>
+#include <vector>
 
 #include "soc/soc_top.h"
 #include "vkit/env.hpp"
@@ -10,7 +11,8 @@ struct tb_top : sc_core::sc_module {
   env*             e{};
   vkit::sequencer* seq{};
 
-  // No SC_HAS_PROCESS, no SC_THREAD  this is a pure container.
+  SC_HAS_PROCESS(tb_top);
+
   explicit tb_top(sc_core::sc_module_name nm)
   : sc_core::sc_module(nm)
   {
@@ -25,9 +27,44 @@ struct tb_top : sc_core::sc_module {
     e   = new env("env", "soc/manifest.json");
     e->seq = seq;
     e->soc = soc;
+
+    // Phase order follows this list
+    comps = {e, seq};
+
+    SC_THREAD(run_phases);
   }
-};
 
+  // build/connect run during elaboration, so the agents they create are
+  // regular modules and may own processes and sockets.
+  void before_end_of_elaboration() override {
+    SC_REPORT_INFO(name(), "Calling build/connect phases");
+    for (auto* c : comps) c->build_phase();
+    for (auto* c : comps) c->connect_phase();
+  }
+
+private:
+  // run_phase of every component runs as its own process; the test ends
+  // when the last run objection is dropped.
+  void run_phases() {
+    SC_REPORT_INFO(name(), "Starting run_phase");
+    for (auto* c : comps) {
+      sc_core::sc_spawn([c] { c->run_phase(); },
+                        (std::string(c->basename()) + "_run").c_str());
+    }
+    wait(sc_core::SC_ZERO_TIME);   // let every run_phase raise its objections
+    vkit::component::run_objection().wait_for_zero();
+
+    std::string msg = "run_phase complete at " + sc_core::sc_time_stamp().to_string();
+    SC_REPORT_INFO(name(), msg.c_str());
+
+    for (auto* c : comps) c->extract_phase();
+    for (auto* c : comps) c->check_phase();
+    for (auto* c : comps) c->report_phase();
+    sc_core::sc_stop();
+  }
+
+  std::vector<vkit::component*> comps;
+};
 
 // sim/tb_top.cpp
 /*
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <systemc>
+#include <tlm>
+#include <tlm_utils/multi_passthrough_initiator_socket.h>
+#include <tlm_utils/multi_passthrough_target_socket.h>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Address-decoding TLM-2.0 interconnect. Any number of initiators bind to
+// t_skt; targets are bound to i_skt in the order they are added with
+// add_target(), which also places them in the memory map. Decode is a
+// binary search over the sorted region table plus a last-hit check, so the
+// routing cost is flat for back-to-back accesses to one IP and grows only
+// logarithmically with IP count. The target sees addresses relative to its
+// own base.
+struct bus : sc_core::sc_module {
+  tlm_utils::multi_passthrough_target_socket<bus>    t_skt;  // from agents
+  tlm_utils::multi_passthrough_initiator_socket<bus> i_skt;  // to IP register files
+
+  SC_HAS_PROCESS(bus);
+
+  explicit bus(sc_core::sc_module_name nm)
+  : sc_core::sc_module(nm)
+  , t_skt("t_skt")
+  , i_skt("i_skt")
+  {
+    t_skt.register_b_transport(this, &bus::b_transport);
+    t_skt.register_transport_dbg(this, &bus::transport_dbg);
+  }
+
+  // Adds [base, base+size) to the map; the caller binds i_skt to the
+  // target right after, so the returned port index matches the binding.
+  template<class TARGET_SOCKET>
+  void add_target(const std::string& name, std::uint64_t base, std::uint64_t size,
+                  TARGET_SOCKET& tgt) {
+    if (size == 0 || base + size < base) {
+      SC_REPORT_ERROR(this->name(), ("Bad region for " + name).c_str());
+      return;
+    }
+    region r{base, base + size, static_cast<int>(ports_++), name};
+    auto it = std::upper_bound(map_.begin(), map_.end(), r.base,
+                               [](std::uint64_t a, const region& x) { return a < x.base; });
+    if ((it != map_.end() && it->base < r.end) ||
+        (it != map_.begin() && std::prev(it)->end > r.base)) {
+      SC_REPORT_ERROR(this->name(), ("Region of " + name + " overlaps another IP").c_str());
+    }
+    map_.insert(it, r);
+    last_ = nullptr;
+    i_skt.bind(tgt);
+  }
+
+private:
+  struct region {
+    std::uint64_t base;
+    std::uint64_t end;    // exclusive
+    int           port;
+    std::string   name;
+  };
+
+  const region* decode(std::uint64_t addr) {
+    if (last_ && addr >= last_->base && addr < last_->end) return last_;
+    auto it = std::upper_bound(map_.begin(), map_.end(), addr,
+                               [](std::uint64_t a, const region& x) { return a < x.base; });
+    if (it == map_.begin()) return nullptr;
+    --it;
+    if (addr >= it->end) return nullptr;
+    last_ = &*it;
+    return last_;
+  }
+
+  // Routes gp to the owning target; false (with an address error) if the
+  // access is unmapped or runs past the end of the target's window.
+  const region* route(tlm::tlm_generic_payload& gp) {
+    const std::uint64_t addr = gp.get_address();
+    const region* r = decode(addr);
+    const unsigned sw  = gp.get_streaming_width();
+    const unsigned len = gp.get_data_length();
+    const std::uint64_t span = (sw && sw < len) ? sw : len;
+    if (!r || span > r->end - addr) {
+      gp.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+      return nullptr;
+    }
+    gp.set_address(addr - r->base);
+    return r;
+  }
+
+  void b_transport(int, tlm::tlm_generic_payload& gp, sc_core::sc_time& delay) {
+    const std::uint64_t addr = gp.get_address();
+    if (const region* r = route(gp)) {
+      i_skt[r->port]->b_transport(gp, delay);
+      gp.set_address(addr);
+    }
+  }
+
+  unsigned transport_dbg(int, tlm::tlm_generic_payload& gp) {
+    const std::uint64_t addr = gp.get_address();
+    unsigned n = 0;
+    if (const region* r = route(gp)) {
+      n = i_skt[r->port]->transport_dbg(gp);
+      gp.set_address(addr);
+    }
+    return n;
+  }
+
+  std::vector<region> map_;          // sorted by base
+  const region*       last_{nullptr};
+  unsigned            ports_{0};
+};
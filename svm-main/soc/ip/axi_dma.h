@@ -5,25 +5,40 @@
 #include <string>
 #include <sstream>
 
-struct axi_dma : sc_core::sc_module {
+#include "reg_target.h"
+
+// Register map (32-bit registers, offsets from the IP base):
+//   0x00 SRC_LO  RW      0x04 SRC_HI  RW
+//   0x08 DST_LO  RW      0x0C DST_HI  RW
+//   0x10 LEN     RW
+//   0x14 CTRL    W   bit0 start: runs the burst programmed above
+//   0x18 STATUS  R   number of completed bursts
+struct axi_dma : reg_target {
+  static constexpr std::uint64_t SRC_LO = 0x00;
+  static constexpr std::uint64_t SRC_HI = 0x04;
+  static constexpr std::uint64_t DST_LO = 0x08;
+  static constexpr std::uint64_t DST_HI = 0x0C;
+  static constexpr std::uint64_t LEN    = 0x10;
+  static constexpr std::uint64_t CTRL   = 0x14;
+  static constexpr std::uint64_t STATUS = 0x18;
+
   // Last command info (for debugging/introspection)
   std::uint64_t last_src{0};
   std::uint64_t last_dst{0};
   std::uint32_t last_len{0};
+  std::uint32_t done{0};
 
   SC_HAS_PROCESS(axi_dma);
 
   explicit axi_dma(sc_core::sc_module_name nm)
-  : sc_core::sc_module(nm)
-  {
-    // No TLM target sockets here anymore.
-    // This avoids unbound sc_port/sc_export errors during elaboration.
-  }
+  : reg_target(nm)
+  {}
 
   void do_burst(std::uint64_t src, std::uint64_t dst, std::uint32_t len) {
     last_src = src;
     last_dst = dst;
     last_len = len;
+    ++done;
 
     std::string msg = "DMA burst: src=0x" + to_hex(src) +
                       " dst=0x" + to_hex(dst) +
@@ -31,10 +46,45 @@ struct axi_dma : sc_core::sc_module {
     SC_REPORT_INFO(name(), msg.c_str());
   }
 
+  std::uint32_t reg_read(std::uint64_t off) override {
+    switch (off) {
+      case SRC_LO: return static_cast<std::uint32_t>(src_);
+      case SRC_HI: return static_cast<std::uint32_t>(src_ >> 32);
+      case DST_LO: return static_cast<std::uint32_t>(dst_);
+      case DST_HI: return static_cast<std::uint32_t>(dst_ >> 32);
+      case LEN:    return len_;
+      case STATUS: return done;
+      default:     return 0;
+    }
+  }
+
+  void reg_write(std::uint64_t off, std::uint32_t val, std::uint32_t mask) override {
+    switch (off) {
+      case SRC_LO: merge(src_, 0,  val, mask); break;
+      case SRC_HI: merge(src_, 32, val, mask); break;
+      case DST_LO: merge(dst_, 0,  val, mask); break;
+      case DST_HI: merge(dst_, 32, val, mask); break;
+      case LEN:    len_ = (len_ & ~mask) | (val & mask); break;
+      case CTRL:
+        if (val & mask & 1u) do_burst(src_, dst_, len_);
+        break;
+      default: break;
+    }
+  }
+
 private:
+  static void merge(std::uint64_t& r, unsigned shift, std::uint32_t val, std::uint32_t mask) {
+    const std::uint64_t m = std::uint64_t(mask) << shift;
+    r = (r & ~m) | ((std::uint64_t(val) << shift) & m);
+  }
+
   static std::string to_hex(std::uint64_t v) {
     std::ostringstream oss;
     oss << std::hex << v;
     return oss.str();
   }
+
+  std::uint64_t src_{0};
+  std::uint64_t dst_{0};
+  std::uint32_t len_{0};
 };
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <systemc>
+#include <tlm>
+#include <tlm_utils/simple_target_socket.h>
+#include <algorithm>
+#include <cstdint>
+
+// Common register-file front-end for the SoC IPs. b_transport splits every
+// access into 32-bit word reads/writes (byte enables and streaming width are
+// honoured) and hands them to the IP. Offsets are relative to the IP's base;
+// the bus has already stripped the base and checked the window size.
+// Unmapped offsets read as zero and ignore writes.
+struct reg_target : sc_core::sc_module {
+  tlm_utils::simple_target_socket<reg_target> reg_tgt;
+
+  explicit reg_target(sc_core::sc_module_name nm,
+                      sc_core::sc_time access_latency = sc_core::sc_time(10, sc_core::SC_NS))
+  : sc_core::sc_module(nm)
+  , reg_tgt("reg_tgt")
+  , latency_(access_latency)
+  {
+    reg_tgt.register_b_transport(this, &reg_target::b_transport);
+  }
+
+  // `mask` has 0xFF in every byte lane the initiator actually wrote
+  virtual std::uint32_t reg_read(std::uint64_t off) = 0;
+  virtual void          reg_write(std::uint64_t off, std::uint32_t val, std::uint32_t mask) = 0;
+
+private:
+  void b_transport(tlm::tlm_generic_payload& gp, sc_core::sc_time& delay) {
+    const std::uint64_t addr = gp.get_address();
+    unsigned char*      ptr  = gp.get_data_ptr();
+    const unsigned      len  = gp.get_data_length();
+    const unsigned char* be  = gp.get_byte_enable_ptr();
+    const unsigned      be_len = gp.get_byte_enable_length();
+    const unsigned      sw   = gp.get_streaming_width() ? gp.get_streaming_width() : len;
+    const bool          wr   = gp.is_write();
+
+    if (gp.get_command() == tlm::TLM_IGNORE_COMMAND) {
+      gp.set_response_status(tlm::TLM_OK_RESPONSE);
+      return;
+    }
+    if (len == 0 || !ptr || (be && be_len == 0)) {
+      gp.set_response_status(tlm::TLM_GENERIC_ERROR_RESPONSE);
+      return;
+    }
+
+    // One word access per beat fragment that stays inside a 32-bit word
+    unsigned i = 0, beats = 0;
+    while (i < len) {
+      const std::uint64_t a    = addr + (i % sw);
+      const std::uint64_t off  = a & ~std::uint64_t(3);
+      const unsigned      lane = static_cast<unsigned>(a & 3);
+      const unsigned      n    = std::min({4 - lane, len - i, sw - (i % sw)});
+
+      std::uint32_t val = 0, mask = 0;
+      for (unsigned k = 0; k < n; ++k) {
+        if (be && be[(i + k) % be_len] == tlm::TLM_BYTE_DISABLED) continue;
+        const unsigned sh = 8 * (lane + k);
+        mask |= std::uint32_t(0xFF) << sh;
+        val  |= std::uint32_t(ptr[i + k]) << sh;
+      }
+
+      if (wr) {
+        if (mask) reg_write(off, val, mask);
+      } else if (mask) {
+        const std::uint32_t r = reg_read(off);
+        for (unsigned k = 0; k < n; ++k) {
+          const unsigned sh = 8 * (lane + k);
+          if ((mask >> sh) & 0xFF) ptr[i + k] = static_cast<unsigned char>(r >> sh);
+        }
+      }
+      i += n;
+      ++beats;
+    }
+
+    delay += latency_ * beats;
+    gp.set_response_status(tlm::TLM_OK_RESPONSE);
+  }
+
+  sc_core::sc_time latency_;
+};
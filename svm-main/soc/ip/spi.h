@@ -1,24 +1,61 @@
 #pragma once
 
 #include <systemc>
+#include <deque>
 #include <vector>
 #include <cstdint>
 
-struct spi : sc_core::sc_module {
+#include "reg_target.h"
+
+// Register map (32-bit registers, offsets from the IP base):
+//   0x00 TXDATA  W   byte [7:0] is shifted out; the looped-back byte lands in RX
+//   0x04 RXDATA  R   pops one received byte (0 when empty)
+//   0x08 MODE    RW  [1:0] CPOL/CPHA
+//   0x0C STATUS  R   number of bytes waiting in RXDATA
+struct spi : reg_target {
+  static constexpr std::uint64_t TXDATA = 0x00;
+  static constexpr std::uint64_t RXDATA = 0x04;
+  static constexpr std::uint64_t MODE   = 0x08;
+  static constexpr std::uint64_t STATUS = 0x0C;
+
   unsigned mode{0};
 
   SC_HAS_PROCESS(spi);
 
   explicit spi(sc_core::sc_module_name nm)
-  : sc_core::sc_module(nm)
-  {
-    // Stub implementation: no TLM sockets yet.
-    // Add processes / interfaces later when you model real SPI behavior.
-  }
+  : reg_target(nm)
+  {}
 
   // Simple behavioral hook you can call later if you want:
   void xfer(const std::vector<std::uint8_t>& tx, std::vector<std::uint8_t>& rx) {
     // For now, just loop back.
     rx = tx;
   }
+
+  std::uint32_t reg_read(std::uint64_t off) override {
+    switch (off) {
+      case RXDATA: {
+        if (rx_.empty()) return 0;
+        const std::uint8_t b = rx_.front();
+        rx_.pop_front();
+        return b;
+      }
+      case MODE:   return mode;
+      case STATUS: return static_cast<std::uint32_t>(rx_.size());
+      default:     return 0;
+    }
+  }
+
+  void reg_write(std::uint64_t off, std::uint32_t val, std::uint32_t mask) override {
+    switch (off) {
+      case TXDATA:
+        if (mask & 0xFF) rx_.push_back(static_cast<std::uint8_t>(val));   // loopback
+        break;
+      case MODE: mode = ((mode & ~mask) | (val & mask)) & 0x3; break;
+      default:   break;
+    }
+  }
+
+private:
+  std::deque<std::uint8_t> rx_;
 };
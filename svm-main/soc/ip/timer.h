@@ -3,7 +3,19 @@
 #include <systemc>
 #include <cstdint>
 
-struct timer : sc_core::sc_module {
+#include "reg_target.h"
+
+// Register map (32-bit registers, offsets from the IP base):
+//   0x00 CTRL       RW  bit0 run (writing 1 starts, 0 stops)
+//   0x04 PERIOD_US  RW  tick period in microseconds
+//   0x08 TICKS_LO   R
+//   0x0C TICKS_HI   R
+struct timer : reg_target {
+  static constexpr std::uint64_t CTRL      = 0x00;
+  static constexpr std::uint64_t PERIOD_US = 0x04;
+  static constexpr std::uint64_t TICKS_LO  = 0x08;
+  static constexpr std::uint64_t TICKS_HI  = 0x0C;
+
   bool          running{false};
   unsigned      period_us{10};   // tick period in microseconds
   std::uint64_t ticks{0};        // number of ticks since start
@@ -11,7 +23,7 @@ struct timer : sc_core::sc_module {
   SC_HAS_PROCESS(timer);
 
   explicit timer(sc_core::sc_module_name nm)
-  : sc_module(nm)
+  : reg_target(nm)
   {
     SC_THREAD(run);
   }
@@ -29,6 +41,31 @@ struct timer : sc_core::sc_module {
     SC_REPORT_INFO(name(), "Timer stopped");   // ? no sc_core::
   }
 
+  std::uint32_t reg_read(std::uint64_t off) override {
+    switch (off) {
+      case CTRL:      return running ? 1u : 0u;
+      case PERIOD_US: return period_us;
+      case TICKS_LO:  return static_cast<std::uint32_t>(ticks);
+      case TICKS_HI:  return static_cast<std::uint32_t>(ticks >> 32);
+      default:        return 0;
+    }
+  }
+
+  void reg_write(std::uint64_t off, std::uint32_t val, std::uint32_t mask) override {
+    switch (off) {
+      case CTRL:
+        if (mask & 1u) {
+          if (val & 1u) start(period_us); else stop();
+        }
+        break;
+      case PERIOD_US:
+        period_us = (period_us & ~mask) | (val & mask);
+        if (period_us == 0) period_us = 1;
+        break;
+      default: break;
+    }
+  }
+
 private:
   void run() {
     while (true) {
@@ -1,16 +1,50 @@
 #pragma once
 
 #include <systemc>
+#include <cstdint>
 
-struct uart : sc_core::sc_module {
-  // You can add internal state here later (FIFOs, config, etc.)
+#include "reg_target.h"
+
+// Register map (32-bit registers, offsets from the IP base):
+//   0x00 TXDATA  W   byte [7:0] is transmitted (stream bursts push one byte per beat)
+//   0x04 STATUS  R   bit0 tx_ready (always 1: no line timing modeled here)
+//   0x08 BAUD    RW
+//   0x0C CTRL    RW  [1:0] parity (0 none, 1 even, 2 odd)
+struct uart : reg_target {
+  static constexpr std::uint64_t TXDATA = 0x00;
+  static constexpr std::uint64_t STATUS = 0x04;
+  static constexpr std::uint64_t BAUD   = 0x08;
+  static constexpr std::uint64_t CTRL   = 0x0C;
+
+  std::uint32_t baud{115200};
+  std::uint32_t ctrl{0};
+  std::uint64_t tx_bytes{0};   // bytes written to TXDATA
 
   SC_HAS_PROCESS(uart);
 
   explicit uart(sc_core::sc_module_name nm)
-  : sc_core::sc_module(nm)
-  {
-    // No TLM sockets for now, purely a placeholder module.
-    // Framework agents currently just log activity and don't touch the DUT.
+  : reg_target(nm)
+  {}
+
+  std::uint32_t reg_read(std::uint64_t off) override {
+    switch (off) {
+      case STATUS: return 1u;
+      case BAUD:   return baud;
+      case CTRL:   return ctrl;
+      default:     return 0;
+    }
+  }
+
+  void reg_write(std::uint64_t off, std::uint32_t val, std::uint32_t mask) override {
+    switch (off) {
+      case TXDATA:
+        for (unsigned sh = 0; sh < 32; sh += 8) {
+          if ((mask >> sh) & 0xFF) ++tx_bytes;
+        }
+        break;
+      case BAUD: baud = (baud & ~mask) | (val & mask); break;
+      case CTRL: ctrl = (ctrl & ~mask) | (val & mask); break;
+      default:   break;
+    }
   }
 };
@@ -1,43 +1,62 @@
 // soc/soc_top.cpp
-/*
 #include "soc_top.h"
-using namespace sc_core;
-
-soc_top::soc_top(sc_module_name nm)
-: sc_module(nm)
-, ctrl_init("ctrl_init") {
-  u_uart  = std::make_unique<uart>("uart0");
-  u_spi   = std::make_unique<spi>("spi0");
-  u_dma   = std::make_unique<axi_dma>("dma0");
-  u_timer = std::make_unique<timer>("timer0");
-
-  // Example: connect ctrl_init to a simple register router within each IP
-  // (In a real SoC, you'd have a bus fabric. For brevity, we show direct binds.)
-  ctrl_init.bind(u_uart->reg_tgt);
-  ctrl_init.bind(u_spi->reg_tgt);
-  ctrl_init.bind(u_dma->reg_tgt);
-  //ctrl_init.bind(u_timer->reg_tgt);
-}
-*/
 
-#include "soc_top.h"
+#include <fstream>
+#include <nlohmann/json.hpp>
 
 using namespace sc_core;
 
-soc_top::soc_top(sc_module_name nm)
+namespace {
+// Manifest addresses may be JSON numbers or strings such as "0x40000000"
+std::uint64_t to_addr(const nlohmann::json& v) {
+  if (v.is_string()) return std::stoull(v.get<std::string>(), nullptr, 0);
+  return v.get<std::uint64_t>();
+}
+} // namespace
+
+soc_top::soc_top(sc_module_name nm, const std::string& manifest)
 : sc_module(nm)
+, ctrl("ctrl")
 {
-  // Construct IP instances
-  u_uart  = std::make_unique<uart>("uart0");
-  u_spi   = std::make_unique<spi>("spi0");
-  u_dma   = std::make_unique<axi_dma>("dma0");
-  u_timer = std::make_unique<timer>("timer0");
-
-  // NOTE:
-  // We no longer have a ctrl_init bus or bind any TLM target sockets here.
-  // This avoids sc_export "no interface" errors for stubbed IPs.
-  //
-  // When you later add a real control bus and proper TLM target implementations
-  // (with b_transport or simple_target_socket), you can re-introduce a
-  // bus + binding in a controlled way.
+  nlohmann::json j;
+  std::ifstream ifs(manifest);
+  if (!ifs.is_open()) {
+    SC_REPORT_ERROR(name(), "Failed to open SoC manifest");
+    return;
+  }
+  ifs >> j;
+
+  // Construct IP instances and map their register files onto the bus
+  for (auto& ip : j["ips"]) {
+    region r;
+    r.name = ip["name"].get<std::string>();
+    r.type = ip["type"].get<std::string>();
+    if (!ip.contains("base") || !ip.contains("size")) {
+      SC_REPORT_ERROR(name(), ("No base/size in manifest for " + r.name).c_str());
+      continue;
+    }
+    r.base = to_addr(ip["base"]);
+    r.size = to_addr(ip["size"]);
+
+    std::unique_ptr<reg_target> m;
+    if      (r.type == "uart")    m = std::make_unique<uart>(r.name.c_str());
+    else if (r.type == "spi")     m = std::make_unique<spi>(r.name.c_str());
+    else if (r.type == "axi_dma") m = std::make_unique<axi_dma>(r.name.c_str());
+    else if (r.type == "timer")   m = std::make_unique<timer>(r.name.c_str());
+    else {
+      SC_REPORT_ERROR(name(), ("Unknown IP type in manifest: " + r.type).c_str());
+      continue;
+    }
+
+    ctrl.add_target(r.name, r.base, r.size, m->reg_tgt);
+    ips.push_back(std::move(m));
+    memory_map.push_back(r);
+  }
+}
+
+const soc_top::region* soc_top::find(const std::string& ip_name) const {
+  for (const auto& r : memory_map) {
+    if (r.name == ip_name) return &r;
+  }
+  return nullptr;
 }
@@ -1,52 +1,39 @@
 // soc/soc_top.h
-/* 
-#pragma once
-#include <systemc>
-#include <tlm>
-#include <string>
-#include <memory>
-#include "ip/uart.h"
-#include "ip/spi.h"
-#include "ip/axi_dma.h"
-#include "ip/timer.h"
-
-struct soc_top : sc_core::sc_module {
-  // Control bus (e.g., simple TLM target for register access)
-  tlm::tlm_initiator_socket<> ctrl_init; // from testbench/agents to SoC
-
-  // IP instances
-  std::unique_ptr<uart>     u_uart;
-  std::unique_ptr<spi>      u_spi;
-  std::unique_ptr<axi_dma>  u_dma;
-  std::unique_ptr<timer>    u_timer;
-
-  SC_HAS_PROCESS(soc_top);
-  soc_top(sc_core::sc_module_name nm);
-};
-*/
-
 #pragma once
 
 #include <systemc>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "bus.h"
+#include "ip/reg_target.h"
 #include "ip/uart.h"
 #include "ip/spi.h"
 #include "ip/axi_dma.h"
 #include "ip/timer.h"
 
-// Minimal SoC top: four IP instances, no control bus for now.
-// Agents will talk to the IPs logically (through their own drivers)
-// rather than via a TLM register bus.
+// SoC top: the IPs listed in the manifest, each behind its register file on
+// a shared address-decoding bus. Agents reach the IPs by binding to ctrl.t_skt
+// and addressing them at the manifest base.
 struct soc_top : sc_core::sc_module {
-  // IP instances
-  std::unique_ptr<uart>     u_uart;
-  std::unique_ptr<spi>      u_spi;
-  std::unique_ptr<axi_dma>  u_dma;
-  std::unique_ptr<timer>    u_timer;
+  struct region {
+    std::string   name;
+    std::string   type;
+    std::uint64_t base{0};
+    std::uint64_t size{0};
+  };
+
+  bus                                      ctrl;        // control/register bus
+  std::vector<std::unique_ptr<reg_target>> ips;
+  std::vector<region>                      memory_map;  // manifest order
 
   SC_HAS_PROCESS(soc_top);
 
-  explicit soc_top(sc_core::sc_module_name nm);
+  explicit soc_top(sc_core::sc_module_name nm,
+                   const std::string& manifest = "soc/manifest.json");
+
+  // Region of the IP instance `name`, or nullptr if the manifest has none
+  const region* find(const std::string& name) const;
 };
@@ -23,7 +23,17 @@ IP_TYPE_BY_PREFIX = {
   "timer": "timer"
 }
 
-def ip_type(ip_name:str)->str:
+def load_manifest_types(path:str)->dict:
+  if not os.path.exists(path):
+    return {}
+  with open(path) as f:
+    m = json.load(f)
+  return {ip["name"]: ip["type"] for ip in m.get("ips", [])}
+
+
+def ip_type(ip_name:str, manifest_types:dict)->str:
+  if ip_name in manifest_types:
+    return manifest_types[ip_name]
   for p,t in IP_TYPE_BY_PREFIX.items():
     if ip_name.startswith(p):
       return t
@@ -64,6 +74,8 @@ def main():
   ap = argparse.ArgumentParser()
   ap.add_argument("dsl", help="DSL YAML file")
   ap.add_argument("--out", default="tests/generated", help="Output dir")
+  ap.add_argument("--manifest", default="soc/manifest.json",
+                  help="SoC manifest; IP types come from here, name prefix is the fallback")
   args = ap.parse_args()
 
   with open(args.dsl) as f:
@@ -71,8 +83,9 @@ def main():
 
   os.makedirs(args.out, exist_ok=True)
   ips = d.get("ips", {})
+  manifest_types = load_manifest_types(args.manifest)
   for ip_name, spec in ips.items():
-    t = ip_type(ip_name)
+    t = ip_type(ip_name, manifest_types)
     gen = GEN_BY_TYPE[t]
     out = gen(ip_name, spec)
     ip_dir = pathlib.Path(args.out) / ip_name
@@ -0,0 +1,127 @@
+// tools/suite2bin.cpp
+//
+// Compiles generated JSON suites into the binary suite.bin format described in
+// vkit/suite_bin.hpp. The sequencer prefers suite.bin when it exists and falls
+// back to suite.json otherwise.
+//
+//   suite2bin <tests_root>               convert every <tests_root>/<ip>/suite.json
+//   suite2bin <suite.json> <suite.bin>   convert a single suite
+
+#include "vkit/suite_bin.hpp"
+#include "vkit/suite_reader.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using nlohmann::json;
+
+namespace {
+
+void put_bytes(vkit::bin_writer& w, const json& v, const char* key) {
+  if (!v.contains(key)) { w.u32(0); return; }
+  const auto& a = v.at(key);
+  w.u32(static_cast<std::uint32_t>(a.size()));
+  for (const auto& b : a) w.u8(static_cast<std::uint8_t>(b.get<int>()));
+}
+
+// Record encoders; defaults mirror the agents' from_json decoders.
+void encode(const std::string& type, const json& v, vkit::bin_writer& w) {
+  if (type == "uart") {
+    const std::string parity = v.value("parity", std::string("none"));
+    w.u32(v.value("baud", 115200u));
+    w.u8(parity == "even" ? 1 : parity == "odd" ? 2 : 0);
+    put_bytes(w, v, "payload");
+  } else if (type == "spi") {
+    w.u32(v.value("mode", 0u));
+    put_bytes(w, v, "tx");
+  } else if (type == "axi_dma") {
+    w.u32(v.value("len", 0u));
+    w.u64(v.at("src").get<std::uint64_t>());
+    w.u64(v.at("dst").get<std::uint64_t>());
+  } else if (type == "timer") {
+    w.u8(v.value("op", std::string("start")) == "start" ? 1 : 0);
+    w.u32(v.value("period_us", 10u));
+  } else {
+    throw std::runtime_error("unknown IP type \"" + type + "\"");
+  }
+}
+
+void convert(const fs::path& in, const fs::path& out) {
+  vkit::suite_reader rd(in.string());
+  if (!rd.ok()) throw std::runtime_error(rd.error());
+  if (rd.type().empty()) throw std::runtime_error("no \"type\" member before \"vectors\"");
+
+  vkit::bin_writer body;
+  std::vector<std::uint64_t> offsets;
+  const std::uint64_t first = vkit::suite_bin_header_sz + rd.type().size();
+
+  json vec;
+  vkit::bin_writer rec;
+  while (rd.next(vec)) {
+    rec.buf.clear();
+    encode(rd.type(), vec, rec);
+    offsets.push_back(first + body.buf.size());
+    body.u32(static_cast<std::uint32_t>(rec.buf.size()));
+    body.bytes(rec.buf.data(), rec.buf.size());
+  }
+  if (!rd.ok()) throw std::runtime_error(rd.error());
+
+  vkit::bin_writer hdr;
+  hdr.bytes(vkit::suite_bin_magic, 4);
+  hdr.u16(vkit::suite_bin_version);
+  hdr.u16(0);
+  hdr.u32(static_cast<std::uint32_t>(offsets.size()));
+  hdr.u32(static_cast<std::uint32_t>(rd.type().size()));
+  hdr.u64(first + body.buf.size());
+  hdr.u64(0);
+  hdr.bytes(rd.type().data(), rd.type().size());
+
+  vkit::bin_writer idx;
+  for (auto o : offsets) idx.u64(o);
+
+  std::ofstream ofs(out, std::ios::binary | std::ios::trunc);
+  ofs.write(hdr.buf.data(),  static_cast<std::streamsize>(hdr.buf.size()));
+  ofs.write(body.buf.data(), static_cast<std::streamsize>(body.buf.size()));
+  ofs.write(idx.buf.data(),  static_cast<std::streamsize>(idx.buf.size()));
+  if (!ofs) throw std::runtime_error("write failed: " + out.string());
+
+  std::cout << in.string() << " -> " << out.string()
+            << " (" << offsets.size() << " vectors)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 2 && argc != 3) {
+    std::cerr << "usage: suite2bin <tests_root>\n"
+                 "       suite2bin <suite.json> <suite.bin>\n";
+    return 2;
+  }
+
+  std::vector<std::pair<fs::path, fs::path>> jobs;
+  if (argc == 3) {
+    jobs.emplace_back(argv[1], argv[2]);
+  } else {
+    for (const auto& d : fs::directory_iterator(argv[1])) {
+      const auto js = d.path() / "suite.json";
+      if (d.is_directory() && fs::exists(js)) jobs.emplace_back(js, d.path() / "suite.bin");
+    }
+  }
+
+  int rc = 0;
+  for (const auto& [in, out] : jobs) {
+    try {
+      convert(in, out);
+    } catch (const std::exception& e) {
+      std::cerr << in.string() << ": " << e.what() << "\n";
+      rc = 1;
+    }
+  }
+  return rc;
+}
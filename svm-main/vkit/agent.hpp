@@ -1,14 +1,37 @@
 // vkit/agent.hpp
 #pragma once
 #include "base.hpp"
+#include "bus_master.hpp"
 #include <tlm>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <cstddef>
 #include <optional>
 namespace vkit {
-struct sequence_item { virtual ~sequence_item() = default; };
+struct sequence_item {
+  virtual ~sequence_item() = default;
+  // Bytes reserved by the item's buffers; lets item_pool count reallocations
+  std::size_t capacity() const { return 0; }
+};
+
+// Read-only view over a block of items (std::span stand-in for C++17)
+struct item_span {
+  const sequence_item* const* ptr{nullptr};
+  std::size_t                 n{0};
+
+  const sequence_item* const* begin() const { return ptr; }
+  const sequence_item* const* end()   const { return ptr + n; }
+  std::size_t size()  const { return n; }
+  bool        empty() const { return n == 0; }
+  const sequence_item* operator[](std::size_t i) const { return ptr[i]; }
+};
 
 struct driver_if {
   virtual ~driver_if() = default;
   virtual void drive(const sequence_item& it) = 0;
+  // Drivers override this to amortize per-call work across a whole block
+  virtual void drive_batch(item_span items) {
+    for (const auto* it : items) drive(*it);
+  }
 };
 
 struct monitor_if {
@@ -23,7 +46,14 @@ struct scoreboard_if {
 };
 
 struct agent : component {
-  using component::component;
+  // Register bus port, bound to the SoC interconnect by env::connect_phase;
+  // drivers reach their IP through `regs` (base set from the memory map).
+  tlm_utils::simple_initiator_socket<agent> bus;
+  bus_master                                regs;
+
+  explicit agent(sc_core::sc_module_name nm)
+    : component(nm), bus("bus"), regs(bus) {}
+
   virtual driver_if*    driver()    = 0;
   virtual monitor_if*   monitor()   = 0; // may be null until post-verify
   virtual scoreboard_if*scoreboard()= 0; // may be null until post-verify
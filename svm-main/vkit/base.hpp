@@ -5,6 +5,28 @@
 #include <memory>
 #include <functional>
 namespace vkit {
+// UVM-style end-of-test detection: the run phase is over once every raised
+// objection has been dropped again.
+class objection {
+public:
+  void raise(unsigned n = 1) { count_ += n; }
+  void drop(unsigned n = 1) {
+    count_ = n > count_ ? 0 : count_ - n;
+    if (count_ == 0) zero_.notify(sc_core::SC_ZERO_TIME);
+  }
+  unsigned count() const { return count_; }
+
+  // Blocks the calling thread until nothing holds an objection.
+  void wait_for_zero() { while (count_ != 0) sc_core::wait(zero_); }
+
+private:
+  unsigned          count_{0};
+  sc_core::sc_event zero_;
+};
+
+// Phases: build_phase/connect_phase run during elaboration, run_phase runs
+// as its own process in simulation time, then extract/check/report (see
+// tb_top). start_of_simulation is the regular SystemC callback.
 struct component : sc_core::sc_module {
   using sc_module::sc_module;
   virtual void build_phase() {}
@@ -14,5 +36,13 @@ struct component : sc_core::sc_module {
   virtual void extract_phase() {}
   virtual void check_phase() {}
   virtual void report_phase() {}
+
+  // Shared by every component; run_phase holds one while it has work left.
+  static objection& run_objection() {
+    static objection o;
+    return o;
+  }
+  void raise_objection() { run_objection().raise(); }
+  void drop_objection()  { run_objection().drop(); }
 };
 }
@@ -0,0 +1,83 @@
+// vkit/bus_master.hpp
+#pragma once
+#include <systemc>
+#include <tlm>
+#include <cstdint>
+#include <string>
+
+namespace vkit {
+// Register access helper for drivers. Issues blocking TLM-2.0 transactions
+// through the owning agent's initiator socket at `base` + offset, reusing one
+// generic payload, and consumes the annotated delay before returning (so it
+// must be called from a thread process, e.g. the sequencer's drive process).
+class bus_master {
+public:
+  std::uint64_t base{0};   // IP base address from the SoC memory map
+
+  explicit bus_master(tlm::tlm_initiator_socket<>& socket) : socket_(socket) {}
+
+  void write32(std::uint64_t off, std::uint32_t v) {
+    std::uint8_t b[4] = {std::uint8_t(v), std::uint8_t(v >> 8),
+                         std::uint8_t(v >> 16), std::uint8_t(v >> 24)};
+    access(tlm::TLM_WRITE_COMMAND, off, b, 4, 4);
+  }
+
+  std::uint32_t read32(std::uint64_t off) {
+    std::uint8_t b[4] = {};
+    access(tlm::TLM_READ_COMMAND, off, b, 4, 4);
+    return std::uint32_t(b[0]) | std::uint32_t(b[1]) << 8 |
+           std::uint32_t(b[2]) << 16 | std::uint32_t(b[3]) << 24;
+  }
+
+  // Consecutive 32-bit registers starting at `off` in a single transaction
+  void write_block(std::uint64_t off, const std::uint32_t* v, unsigned n) {
+    buf_.resize(4u * n);
+    for (unsigned i = 0; i < n; ++i) {
+      for (unsigned k = 0; k < 4; ++k) buf_[4 * i + k] = char(v[i] >> (8 * k));
+    }
+    access(tlm::TLM_WRITE_COMMAND, off, reinterpret_cast<std::uint8_t*>(&buf_[0]), 4 * n, 4 * n);
+  }
+
+  // Byte stream into / out of one data register (streaming width 1)
+  void write_stream(std::uint64_t off, const std::uint8_t* p, unsigned n) {
+    if (n) access(tlm::TLM_WRITE_COMMAND, off, const_cast<std::uint8_t*>(p), n, 1);
+  }
+  void read_stream(std::uint64_t off, std::uint8_t* p, unsigned n) {
+    if (n) access(tlm::TLM_READ_COMMAND, off, p, n, 1);
+  }
+
+private:
+  void access(tlm::tlm_command cmd, std::uint64_t off, std::uint8_t* p,
+              unsigned len, unsigned sw) {
+    gp_.set_command(cmd);
+    gp_.set_address(base + off);
+    gp_.set_data_ptr(p);
+    gp_.set_data_length(len);
+    gp_.set_streaming_width(sw);
+    gp_.set_byte_enable_ptr(nullptr);
+    gp_.set_byte_enable_length(0);
+    gp_.set_dmi_allowed(false);
+    gp_.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+
+    sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
+    socket_->b_transport(gp_, delay);
+    if (gp_.is_response_error()) {
+      std::string msg = "Register access failed at 0x" + hex(base + off) +
+                        ": " + gp_.get_response_string();
+      SC_REPORT_ERROR("bus_master", msg.c_str());
+    }
+    if (delay != sc_core::SC_ZERO_TIME) sc_core::wait(delay);
+  }
+
+  static std::string hex(std::uint64_t v) {
+    static const char digits[] = "0123456789abcdef";
+    std::string s;
+    do { s.insert(s.begin(), digits[v & 0xF]); v >>= 4; } while (v);
+    return s;
+  }
+
+  tlm::tlm_initiator_socket<>& socket_;
+  tlm::tlm_generic_payload     gp_;
+  std::string                  buf_;
+};
+}
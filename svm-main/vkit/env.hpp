@@ -2,10 +2,12 @@
 
 #include "factory.hpp"
 #include "sequencer.hpp"
+#include "soc/soc_top.h"
 #include "utils/json.hpp"
 
 #include <fstream>
 #include <string>
+#include <unordered_map>
 
 // Include agent types so we can register them
 #include "agents/uart_agent.hpp"
@@ -16,39 +18,35 @@
 struct env : vkit::component {
   vkit::sequencer* seq{};                  // Provided by tb_top
   factory<vkit::agent> agent_factory;
+  std::unordered_map<std::string, vkit::deserializer> deserializers; // key: IP type
   std::string manifest_path;
-  sc_core::sc_module* soc{};               // Provided by tb_top
+  soc_top* soc{};                          // Provided by tb_top
 
   env(sc_core::sc_module_name nm, const std::string& manifest)
     : vkit::component(nm)
     , manifest_path(manifest)
   {}
 
-  void build_phase() override {
-    // Register known agents with explicit std::string parameter
-    agent_factory.reg("uart",
-      [](const std::string& n) -> vkit::agent* {
-        return new uart_agent(n.c_str());
-      });
-
-    agent_factory.reg("spi",
-      [](const std::string& n) -> vkit::agent* {
-        return new spi_agent(n.c_str());
-      });
-
-    agent_factory.reg("axi_dma",
+  // Registers an agent type with both the factory and its vector decoders
+  template<class A>
+  void reg_agent(const std::string& type) {
+    agent_factory.reg(type,
       [](const std::string& n) -> vkit::agent* {
-        return new axi_dma_agent(n.c_str());
+        return new A(n.c_str());
       });
+    deserializers[type] = vkit::deserializer{&A::from_json, &A::from_bin};
+  }
 
-    agent_factory.reg("timer",
-      [](const std::string& n) -> vkit::agent* {
-        return new timer_agent(n.c_str());
-      });
+  void build_phase() override {
+    // Register known agents together with their vector decoders
+    reg_agent<uart_agent>("uart");
+    reg_agent<spi_agent>("spi");
+    reg_agent<axi_dma_agent>("axi_dma");
+    reg_agent<timer_agent>("timer");
   }
 
   void connect_phase() override {
-    // Parse manifest, instantiate agents, connect sockets (later)
+    // Parse manifest, instantiate agents, bind them to the SoC register bus
     json j;
     std::ifstream ifs(manifest_path);
     if (!ifs.is_open()) {
@@ -68,10 +66,24 @@ struct env : vkit::component {
         continue;
       }
 
-      // TODO: connect agent driver/monitor sockets to SoC here
-      // For now, just register with the sequencer so tests can run.
+      // Every agent is an initiator on the SoC control bus; its drivers
+      // address the IP relative to the base from the SoC memory map.
+      if (soc) {
+        ag->bus.bind(soc->ctrl.t_skt);
+        if (const auto* r = soc->find(ip_name)) {
+          ag->regs.base = r->base;
+        } else {
+          std::string msg = "IP not in SoC memory map: " + ip_name;
+          SC_REPORT_ERROR(name(), msg.c_str());
+        }
+      } else {
+        SC_REPORT_ERROR(name(), "SoC pointer is null in env");
+      }
+
+      // Decoders are looked up by manifest type here, once, so the
+      // sequencer never dispatches on IP names.
       if (seq) {
-        seq->register_agent(ip_name, ag);
+        seq->register_agent(ip_name, ag, ip_type, deserializers.at(ip_type));
       } else {
         SC_REPORT_ERROR(name(), "Sequencer pointer is null in env");
       }
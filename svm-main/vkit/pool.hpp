@@ -0,0 +1,92 @@
+// vkit/pool.hpp
+#pragma once
+
+#include "agent.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vkit {
+
+// Common part of every item pool, so the sequencer can report on all of them.
+class pool_base {
+public:
+  explicit pool_base(std::string type) : type_(std::move(type)) { all().push_back(this); }
+  virtual ~pool_base() = default;
+
+  virtual void recycle(sequence_item* it) = 0;
+
+  const std::string& type()        const { return type_; }
+  std::size_t        acquires()    const { return acquires_; }
+  std::size_t        misses()      const { return misses_; }   // acquires with no free item (a new T)
+  std::size_t        growths()     const { return growths_; }  // buffer reallocations
+
+  static std::vector<pool_base*>& all() {
+    static std::vector<pool_base*> v;
+    return v;
+  }
+
+protected:
+  std::string type_;
+  std::size_t acquires_{0};
+  std::size_t misses_{0};
+  std::size_t growths_{0};
+};
+
+// Returns an item to its pool instead of freeing it.
+struct item_deleter {
+  pool_base* pool{nullptr};
+  void operator()(sequence_item* it) const {
+    if (pool) pool->recycle(it); else delete it;
+  }
+};
+using item_ptr = std::unique_ptr<sequence_item, item_deleter>;
+
+// Recycling pool for one sequence_item subclass. Released items keep their
+// buffer capacity, so once the pool has warmed up, acquiring an item no
+// longer news one and filling it no longer grows its buffers. The counters
+// only cover the pool itself: decoding (JSON parsing in particular) may
+// still allocate. T provides a static `type_name` and
+// capacity() (bytes reserved by its buffers; sequence_item's default is 0).
+template<class T>
+class item_pool : public pool_base {
+public:
+  static item_pool& instance() {
+    static item_pool p;
+    return p;
+  }
+
+  // Hands out a recycled item (as last used) and lets `fill` overwrite it.
+  // Buffer reallocations made by `fill` are counted as growths.
+  template<class Fill>
+  item_ptr make(Fill&& fill) {
+    ++acquires_;
+    T* t;
+    if (free_.empty()) {
+      ++misses_;
+      t = new T();
+    } else {
+      t = free_.back();
+      free_.pop_back();
+    }
+    const std::size_t cap = t->capacity();
+    fill(*t);
+    if (t->capacity() != cap) ++growths_;
+    return item_ptr(t, item_deleter{this});
+  }
+
+  void recycle(sequence_item* it) override { free_.push_back(static_cast<T*>(it)); }
+
+  ~item_pool() override {
+    for (T* t : free_) delete t;
+  }
+
+private:
+  item_pool() : pool_base(T::type_name) { free_.reserve(16); }
+
+  std::vector<T*> free_;
+};
+
+} // namespace vkit
@@ -1,59 +1,76 @@
 #include "sequencer.hpp"
 
-#include "agents/uart_agent.hpp"
-#include "agents/spi_agent.hpp"
-#include "agents/axi_dma_agent.hpp"
-#include "agents/timer_agent.hpp"
-
 using nlohmann::json; // from vkit/utils/json.hpp via sequencer.hpp
 
-std::unique_ptr<vkit::sequence_item>
-vkit::sequencer::ag_deserialize(const std::string& ip, const json& v) {
-  // UART
-  if (ip.rfind("uart", 0) == 0) {
-    auto p = std::make_unique<items::uart_tx>();
-    p->baud   = v.value("baud", 115200u);
-    // parity in JSON is stored as string ("none", etc.), we keep a bool stub
-    p->parity = false;
-    if (v.contains("payload")) {
-      for (auto b : v["payload"]) {
-        p->payload.push_back(static_cast<std::uint8_t>(b.get<int>()));
-      }
+// Body of one per-IP drive process. A compiled suite.bin (tools/suite2bin)
+// wins over suite.json, unless it is older than the JSON it was built from.
+void vkit::sequencer::drive_suite(const std::string& ip, ip_entry& e) {
+  namespace fs = std::filesystem;
+  const auto dir  = tests_root / ip;
+  const auto bin  = dir / "suite.bin";
+  const auto src  = dir / "suite.json";
+  const bool has_bin  = fs::exists(bin);
+  const bool has_json = fs::exists(src);
+  bool use_bin = has_bin;
+  if (has_bin && has_json) {
+    std::error_code ec_bin, ec_json;
+    const auto t_bin  = fs::last_write_time(bin, ec_bin);
+    const auto t_json = fs::last_write_time(src, ec_json);
+    if (!ec_bin && !ec_json && t_bin < t_json) {
+      SC_REPORT_WARNING(name(), (bin.string() + " is older than suite.json, "
+                                 "using the JSON (re-run tools/suite2bin)").c_str());
+      use_bin = false;
     }
-    return p;
   }
-
-  // SPI
-  if (ip.rfind("spi", 0) == 0) {
-    auto p = std::make_unique<items::spi_xfer>();
-    p->mode = v.value("mode", 0u);
-    if (v.contains("tx")) {
-      for (auto b : v["tx"]) {
-        p->tx.push_back(static_cast<std::uint8_t>(b.get<int>()));
-      }
-    }
-    return p;
+  e.has_suite = true;
+  if (use_bin) {
+    drive_bin(e, bin);
+  } else if (has_json) {
+    drive_json(e, src);
+  } else {
+    SC_REPORT_WARNING(name(), ("No tests for IP " + ip).c_str());
+    e.has_suite = false;
   }
+}
 
-  // DMA
-  if (ip.rfind("dma", 0) == 0) {
-    auto p = std::make_unique<items::dma_burst>();
-    p->len = v.value("len", 0u);
-    p->src = v.at("src").get<std::uint64_t>();
-    p->dst = v.at("dst").get<std::uint64_t>();
-    return p;
+void vkit::sequencer::drive_json(const ip_entry& e, const std::filesystem::path& file) {
+  // Stream the suite: one vector is parsed and driven at a time
+  suite_reader rd(file.string());
+  json vec;
+  batcher out(e.ag->driver(), batch_size);
+  // Pre-verify: only driver is active
+  while (rd.next(vec)) {
+    // Deserialize to a concrete item understood by the agent
+    auto item = e.deser.from_json(vec);
+    if (item) out.push(std::move(item));
   }
-
-  // TIMER
-  if (ip.rfind("timer", 0) == 0) {
-    auto p = std::make_unique<items::timer_cmd>();
-    const std::string op = v.value("op", std::string("start"));
-    p->start     = (op == "start");
-    p->period_us = v.value("period_us", 10u);
-    return p;
+  out.flush();
+  if (!rd.ok()) {
+    SC_REPORT_ERROR(name(), (file.string() + ": " + rd.error()).c_str());
   }
+}
 
-  // Unknown IP type
-  SC_REPORT_WARNING("sequencer", ("ag_deserialize: unknown IP " + ip).c_str());
-  return {};
+void vkit::sequencer::drive_bin(const ip_entry& e, const std::filesystem::path& file) {
+  bin_suite suite(file.string());
+  if (!suite.ok()) {
+    SC_REPORT_ERROR(name(), (file.string() + ": " + suite.error()).c_str());
+    return;
+  }
+  if (suite.type() != e.type) {
+    std::string msg = file.string() + ": compiled for type " +
+                      std::string(suite.type()) + ", manifest says " + e.type;
+    SC_REPORT_ERROR(name(), msg.c_str());
+    return;
+  }
+  batcher out(e.ag->driver(), batch_size);
+  for (std::size_t i = 0; i < suite.size(); ++i) {
+    bin_cursor rec = suite.record(i);
+    auto item = e.deser.from_bin(rec);
+    if (!item || !rec.ok()) {
+      SC_REPORT_ERROR(name(), (file.string() + ": bad record " + std::to_string(i)).c_str());
+      return;
+    }
+    out.push(std::move(item));
+  }
+  out.flush();
 }
@@ -4,46 +4,128 @@
 #include <fstream>
 #include <string>
 #include "agent.hpp"
+#include "pool.hpp"
+#include "suite_bin.hpp"
+#include "suite_reader.hpp"
 #include "utils/json.hpp"
 #include <map>
 #include <queue>
 #include <filesystem>
+#include <vector>
 
 namespace vkit {
+// Vector decoders for one IP type, registered next to its agent factory entry
+struct deserializer {
+  item_ptr (*from_json)(const nlohmann::json&) = nullptr;
+  item_ptr (*from_bin)(bin_cursor&)            = nullptr;
+};
+
 struct sequencer : component {
-  std::map<std::string, agent*> agents; // key: ip_name
+  // Everything run_phase needs per IP, resolved once at connect time
+  struct ip_entry {
+    agent*       ag{};
+    std::string  type;   // manifest IP type
+    deserializer deser;
+    bool         has_suite{false};
+  };
+
+  std::map<std::string, ip_entry> agents; // key: ip_name
   std::filesystem::path tests_root;
+  std::size_t batch_size{64};             // items per driver_if::drive_batch call
 
   SC_HAS_PROCESS(sequencer);
   sequencer(sc_core::sc_module_name nm, std::filesystem::path root)
     : component(nm), tests_root(std::move(root)) {}
 
-  void register_agent(const std::string& name, agent* a) { agents[name]=a; }
+  void register_agent(const std::string& name, agent* a,
+                      const std::string& type, deserializer d) {
+    agents[name] = ip_entry{a, type, d};
+  }
 
   void run_phase() override {
-    // For each IP, read its generated test suite and drive via its driver
-    for (auto& [ip, ag] : agents) {
-      const auto file = tests_root / ip / "suite.json";
-      if (!std::filesystem::exists(file)) {
-        SC_REPORT_WARNING(name(), ("No tests for IP " + ip).c_str());
-        continue;
-      }
-      nlohmann::json j;
-      std::ifstream ifs(file);
-      ifs >> j;
-      // Pre-verify: only driver is active
-      for (auto& vec : j["vectors"]) {
-        // Deserialize to a concrete item understood by the agent
-        auto item = ag_deserialize(ip, vec);
-        ag->driver()->drive(*item);
-      }
-      // Post-verify: create monitors & scoreboards and run passive checks
-      if (auto m = ag->monitor()) m->start();
-      if (auto s = ag->scoreboard()) s->finalize();
+    raise_objection();
+
+    // One SystemC process per IP, so independent suites drive concurrently
+    // in simulated time instead of back-to-back.
+    std::vector<sc_core::sc_process_handle> procs;
+    for (auto& kv : agents) {
+      const std::string* ip = &kv.first;
+      ip_entry*          e  = &kv.second;
+      raise_objection();
+      procs.push_back(sc_core::sc_spawn([this, ip, e] {
+        drive_suite(*ip, *e);
+        drop_objection();
+      }, (*ip + "_drive").c_str()));
+    }
+
+    // Join: monitors only start once every suite has been driven
+    sc_core::sc_event_and_list pending;
+    for (auto& h : procs) {
+      if (!h.terminated()) pending &= h.terminated_event();
+    }
+    if (pending.size() > 0) sc_core::wait(pending);
+
+    // Post-verify: create monitors & scoreboards and run passive checks
+    for (auto& [ip, e] : agents) {
+      if (!e.has_suite) continue;
+      if (auto m = e.ag->monitor()) m->start();
+    }
+    drop_objection();
+  }
+
+  void check_phase() override {
+    for (auto& [ip, e] : agents) {
+      if (!e.has_suite) continue;
+      if (auto s = e.ag->scoreboard()) s->finalize();
+    }
+  }
+
+  // Item pool statistics: in steady state acquires grow while pool misses
+  // and buffer growths stay flat.
+  void report_phase() override {
+    for (const auto* p : pool_base::all()) {
+      std::string msg = p->type() + " pool: acquires=" + std::to_string(p->acquires()) +
+                        " pool_misses=" + std::to_string(p->misses()) +
+                        " buffer_growths=" + std::to_string(p->growths());
+      SC_REPORT_INFO(name(), msg.c_str());
     }
   }
 
-  std::unique_ptr<sequence_item> ag_deserialize(const std::string& ip,
-                                                const nlohmann::json& v);
+private:
+  void drive_suite(const std::string& ip, ip_entry& e);
+  void drive_json(const ip_entry& e, const std::filesystem::path& file);
+  void drive_bin (const ip_entry& e, const std::filesystem::path& file);
+
+  // Collects decoded items and hands them to the driver batch_size at a time.
+  // The last partial batch is only driven by an explicit flush(): on an
+  // early return, an error or process kill the destructor just releases
+  // the items (it must not wait() or report during unwinding).
+  class batcher {
+  public:
+    batcher(driver_if* d, std::size_t n) : drv_(d), n_(n ? n : 1) {
+      items_.reserve(n_);
+      ptrs_.reserve(n_);
+    }
+    ~batcher() = default;
+
+    void push(item_ptr it) {
+      ptrs_.push_back(it.get());
+      items_.push_back(std::move(it));
+      if (items_.size() == n_) flush();
+    }
+
+    void flush() {
+      if (items_.empty()) return;
+      drv_->drive_batch(item_span{ptrs_.data(), ptrs_.size()});
+      items_.clear();   // items go back to their pools
+      ptrs_.clear();
+    }
+
+  private:
+    driver_if*                         drv_;
+    std::size_t                        n_;
+    std::vector<item_ptr>              items_;
+    std::vector<const sequence_item*>  ptrs_;
+  };
 };
 }
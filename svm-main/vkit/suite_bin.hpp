@@ -0,0 +1,152 @@
+// vkit/suite_bin.hpp
+#pragma once
+
+// Compact binary test-suite format (suite.bin), produced from suite.json by
+// tools/suite2bin and read in place through an mmap by the sequencer.
+//
+// All integers are little-endian.
+//
+//   header  (32 bytes)
+//     char     magic[4]      "SVMB"
+//     uint16   version       suite_bin_version
+//     uint16   reserved
+//     uint32   vector_count
+//     uint32   type_len      length of the IP type string that follows
+//     uint64   index_offset  file offset of the vector index
+//     uint64   reserved
+//   char     type[type_len]  manifest IP type ("uart", "spi", ...)
+//   records                  uint32 body_len, then body_len bytes
+//   index                    uint64 offset[vector_count], one per record
+//
+// Record bodies are per IP type:
+//   uart     u32 baud, u8 parity (0 none, 1 even, 2 odd), u32 n, u8 payload[n]
+//   spi      u32 mode, u32 n, u8 tx[n]
+//   axi_dma  u32 len, u64 src, u64 dst
+//   timer    u8 start, u32 period_us
+
+#include "suite_reader.hpp"   // mapped_file
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace vkit {
+
+constexpr char          suite_bin_magic[4]  = {'S', 'V', 'M', 'B'};
+constexpr std::uint16_t suite_bin_version   = 1;
+constexpr std::size_t   suite_bin_header_sz = 32;
+
+// Bounds-checked little-endian reader over one record body. Byte arrays are
+// returned as pointers into the mapping, never copied.
+class bin_cursor {
+public:
+  bin_cursor() = default;
+  bin_cursor(const std::uint8_t* p, std::size_t n) : p_(p), end_(p + n) {}
+
+  bool ok() const { return ok_; }
+
+  std::uint8_t  u8()  { return static_cast<std::uint8_t>(get(1)); }
+  std::uint16_t u16() { return static_cast<std::uint16_t>(get(2)); }
+  std::uint32_t u32() { return static_cast<std::uint32_t>(get(4)); }
+  std::uint64_t u64() { return get(8); }
+
+  const std::uint8_t* bytes(std::size_t n) {
+    if (!ok_ || static_cast<std::size_t>(end_ - p_) < n) { ok_ = false; return nullptr; }
+    const std::uint8_t* r = p_;
+    p_ += n;
+    return r;
+  }
+
+private:
+  std::uint64_t get(unsigned n) {
+    const std::uint8_t* b = bytes(n);
+    std::uint64_t v = 0;
+    if (b) for (unsigned i = 0; i < n; ++i) v |= std::uint64_t(b[i]) << (8 * i);
+    return v;
+  }
+
+  const std::uint8_t* p_{nullptr};
+  const std::uint8_t* end_{nullptr};
+  bool                ok_{true};
+};
+
+// Little-endian writer used by tools/suite2bin.
+struct bin_writer {
+  std::string buf;
+
+  void u8 (std::uint8_t  v) { put(v, 1); }
+  void u16(std::uint16_t v) { put(v, 2); }
+  void u32(std::uint32_t v) { put(v, 4); }
+  void u64(std::uint64_t v) { put(v, 8); }
+  void bytes(const void* p, std::size_t n) { buf.append(static_cast<const char*>(p), n); }
+
+private:
+  void put(std::uint64_t v, unsigned n) {
+    for (unsigned i = 0; i < n; ++i) buf.push_back(static_cast<char>(v >> (8 * i)));
+  }
+};
+
+// Memory-mapped suite.bin with O(1) access to any vector through the index.
+class bin_suite {
+public:
+  explicit bin_suite(const std::string& path) : file_(path) {
+    if (!file_.ok()) { err_ = file_.error(); return; }
+    base_ = reinterpret_cast<const std::uint8_t*>(file_.data());
+    size_ = file_.size();
+
+    bin_cursor h(base_, size_);
+    const std::uint8_t* magic = h.bytes(4);
+    if (!magic || std::memcmp(magic, suite_bin_magic, 4) != 0) { err_ = "bad magic"; return; }
+    const std::uint16_t ver = h.u16();
+    if (ver != suite_bin_version) {
+      err_ = "unsupported version " + std::to_string(ver);
+      return;
+    }
+    h.u16();
+    count_ = h.u32();
+    const std::uint32_t type_len = h.u32();
+    const std::uint64_t idx      = h.u64();
+    h.u64();
+    const std::uint8_t* type = h.bytes(type_len);
+    if (!h.ok() || !type) { err_ = "truncated header"; return; }
+    type_ = std::string_view(reinterpret_cast<const char*>(type), type_len);
+
+    if (idx > size_ || (size_ - idx) / 8 < count_) { err_ = "truncated index"; return; }
+    index_ = base_ + idx;
+  }
+
+  bool               ok()    const { return err_.empty(); }
+  const std::string& error() const { return err_; }
+  std::string_view   type()  const { return type_; }
+  std::size_t        size()  const { return count_; }
+
+  // Body of vector i; an invalid cursor if the index entry is out of range.
+  bin_cursor record(std::size_t i) const {
+    if (i >= count_) return bad();
+    bin_cursor ix(index_ + 8 * i, 8);
+    const std::uint64_t off = ix.u64();
+    if (off > size_ || size_ - off < 4) return bad();
+    bin_cursor len(base_ + off, 4);
+    const std::uint32_t n = len.u32();
+    if (size_ - off - 4 < n) return bad();
+    return bin_cursor(base_ + off + 4, n);
+  }
+
+private:
+  static bin_cursor bad() {
+    bin_cursor c;
+    c.bytes(1);   // empty range: marks the cursor failed
+    return c;
+  }
+
+  mapped_file         file_;
+  const std::uint8_t* base_{nullptr};
+  const std::uint8_t* index_{nullptr};
+  std::size_t         size_{0};
+  std::size_t         count_{0};
+  std::string_view    type_;
+  std::string         err_;
+};
+
+} // namespace vkit
@@ -0,0 +1,179 @@
+// vkit/suite_reader.hpp
+#pragma once
+
+#include "utils/json.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace vkit {
+
+// Read-only mapping of a whole file. The pages are faulted in lazily by the
+// kernel, so opening a multi-GB suite costs nothing until it is scanned.
+class mapped_file {
+public:
+  explicit mapped_file(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { err_ = std::strerror(errno); return; }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) { err_ = std::strerror(errno); ::close(fd); return; }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+      void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        err_ = std::strerror(errno);
+        size_ = 0;
+      } else {
+        ::madvise(p, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(p);
+      }
+    }
+    ::close(fd);
+  }
+
+  ~mapped_file() {
+    if (data_) ::munmap(const_cast<char*>(data_), size_);
+  }
+
+  mapped_file(const mapped_file&)            = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  bool               ok()    const { return err_.empty(); }
+  const std::string& error() const { return err_; }
+  const char*        data()  const { return data_; }
+  std::size_t        size()  const { return size_; }
+
+private:
+  const char* data_{nullptr};
+  std::size_t size_{0};
+  std::string err_;
+};
+
+// Streams the "vectors" array of a generated suite.json one element at a time.
+// Only the current vector is ever materialized as a json DOM, so memory stays
+// flat regardless of suite size and the first vector is available as soon as
+// its own bytes have been scanned.
+class suite_reader {
+public:
+  explicit suite_reader(const std::string& path) : file_(path) {
+    if (!file_.ok()) { err_ = file_.error(); return; }
+    p_   = file_.data();
+    end_ = p_ + file_.size();
+    seek_vectors();
+  }
+
+  bool               ok()    const { return err_.empty(); }
+  const std::string& error() const { return err_; }
+
+  // Top-level "ip"/"type" members, when they precede "vectors" (as emitted
+  // by tools/dsl2tests.py); empty otherwise.
+  const std::string& ip()    const { return ip_; }
+  const std::string& type()  const { return type_; }
+
+  // Parses the next vector into `out`. Returns false at the end of the array
+  // or on a malformed file (check error() to tell the two apart).
+  bool next(nlohmann::json& out) {
+    if (!in_array_) return false;
+    skip_ws();
+    if (p_ < end_ && *p_ == ',') { ++p_; skip_ws(); }
+    if (p_ >= end_) return fail("unterminated \"vectors\" array");
+    if (*p_ == ']') { ++p_; in_array_ = false; return false; }
+
+    const char* begin = p_;
+    if (!skip_value()) return false;
+    out = nlohmann::json::parse(begin, p_, nullptr, /*allow_exceptions=*/false);
+    if (out.is_discarded()) return fail("malformed vector");
+    return true;
+  }
+
+private:
+  bool fail(const char* why) {
+    err_ = why;
+    in_array_ = false;
+    return false;
+  }
+
+  void skip_ws() {
+    while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) ++p_;
+  }
+
+  // Advances past a JSON string; p_ must point at the opening quote.
+  bool skip_string() {
+    for (++p_; p_ < end_; ++p_) {
+      if (*p_ == '\\') { ++p_; continue; }
+      if (*p_ == '"')  { ++p_; return true; }
+    }
+    return fail("unterminated string");
+  }
+
+  // Advances past one JSON value without building it.
+  bool skip_value() {
+    if (p_ >= end_) return fail("unexpected end of file");
+    if (*p_ == '"') return skip_string();
+    if (*p_ != '{' && *p_ != '[') {
+      while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']') ++p_;
+      return true;
+    }
+    int depth = 0;
+    while (p_ < end_) {
+      const char c = *p_;
+      if (c == '"') { if (!skip_string()) return false; continue; }
+      ++p_;
+      if (c == '{' || c == '[') ++depth;
+      else if ((c == '}' || c == ']') && --depth == 0) return true;
+    }
+    return fail("unbalanced brackets");
+  }
+
+  // Walks the top-level object until the value of "vectors" is reached.
+  void seek_vectors() {
+    skip_ws();
+    if (p_ >= end_ || *p_ != '{') { fail("suite is not a JSON object"); return; }
+    ++p_;
+    while (true) {
+      skip_ws();
+      if (p_ < end_ && *p_ == ',') { ++p_; skip_ws(); }
+      if (p_ >= end_ || *p_ == '}') { fail("no \"vectors\" array"); return; }
+      if (*p_ != '"') { fail("expected member name"); return; }
+
+      const char* key = p_ + 1;
+      if (!skip_string()) return;
+      const std::string_view name(key, static_cast<std::size_t>(p_ - key - 1));
+
+      skip_ws();
+      if (p_ >= end_ || *p_ != ':') { fail("expected ':'"); return; }
+      ++p_;
+      skip_ws();
+
+      if (name == "vectors") {
+        if (p_ >= end_ || *p_ != '[') { fail("\"vectors\" is not an array"); return; }
+        ++p_;
+        in_array_ = true;
+        return;
+      }
+      const char* val = p_;
+      if (!skip_value()) return;
+      if (*val == '"' && (name == "ip" || name == "type")) {
+        (name == "ip" ? ip_ : type_).assign(val + 1, p_ - 1);
+      }
+    }
+  }
+
+  mapped_file file_;
+  const char* p_{nullptr};
+  const char* end_{nullptr};
+  bool        in_array_{false};
+  std::string ip_;
+  std::string type_;
+  std::string err_;
+};
+
+} // namespace vkit